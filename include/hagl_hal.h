@@ -43,6 +43,7 @@ extern "C" {
 #include <hagl/color.h>
 
 #include "nuclei_sdk_soc.h"
+#include "mipi_vendor.h"
 
 #define HAGL_HAL_DEBUG (1)
 
@@ -53,6 +54,9 @@ extern "C" {
 /* Default config is ok for Longan Nano. When compiling you */
 /* can override these by including an user config header */
 /* file first. */
+#ifndef MIPI_DISPLAY_CONTROLLER
+#define MIPI_DISPLAY_CONTROLLER     (MIPI_DISPLAY_CONTROLLER_GENERIC)
+#endif
 #ifndef MIPI_DISPLAY_ADDRESS_MODE
 #define MIPI_DISPLAY_ADDRESS_MODE   (MIPI_DCS_ADDRESS_MODE_BGR)
 #endif
@@ -101,6 +105,28 @@ extern "C" {
 #ifndef MIPI_DISPLAY_PORT_MOSI
 #define MIPI_DISPLAY_PORT_MOSI      (GPIOA)
 #endif
+#ifndef MIPI_DISPLAY_PIN_MISO
+#define MIPI_DISPLAY_PIN_MISO       (0)
+#endif
+#ifndef MIPI_DISPLAY_PORT_MISO
+#define MIPI_DISPLAY_PORT_MISO      (GPIOA)
+#endif
+#ifndef MIPI_DISPLAY_SPI_PRESCALE_COMMAND
+#define MIPI_DISPLAY_SPI_PRESCALE_COMMAND   (SPI_PSC_8)
+#endif
+#ifndef MIPI_DISPLAY_SPI_PRESCALE_PIXEL
+#define MIPI_DISPLAY_SPI_PRESCALE_PIXEL     (SPI_PSC_8)
+#endif
+#ifndef MIPI_DISPLAY_SPI_PRESCALE_READ
+#define MIPI_DISPLAY_SPI_PRESCALE_READ      (SPI_PSC_32)
+#endif
+#ifndef MIPI_DISPLAY_TRANSFER_DMA_THRESHOLD
+#define MIPI_DISPLAY_TRANSFER_DMA_THRESHOLD         (256)
+#endif
+/* Interrupt path is off until enabled and proven faster. */
+#ifndef MIPI_DISPLAY_TRANSFER_INTERRUPT_THRESHOLD
+#define MIPI_DISPLAY_TRANSFER_INTERRUPT_THRESHOLD   (MIPI_DISPLAY_TRANSFER_DMA_THRESHOLD)
+#endif
 #ifndef MIPI_DISPLAY_PIXEL_FORMAT
 #define MIPI_DISPLAY_PIXEL_FORMAT   (MIPI_DCS_PIXEL_FORMAT_16BIT)
 #endif
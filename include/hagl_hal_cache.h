@@ -0,0 +1,103 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Blit cache for single buffer mode. Holds ready to send RGB565 tiles such
+as font glyphs and icons in a fixed size RAM buffer. When the buffer is
+full least recently used tiles are evicted. A cached tile is sent with
+DMA from the cache buffer so the caller does not have to wait for the
+transfer. Tiles are keyed by the identity of the source, such as a font
+glyph, and the color pair so rendering is skipped on a hit.
+
+    if (!hagl_hal_cache_blit(x0, y0, glyph, color, background)) {
+        // Render glyph into bitmap
+        hagl_hal_cache_put(x0, y0, glyph, color, background, &bitmap);
+    }
+
+*/
+
+#ifndef _HAGL_HAL_CACHE_H
+#define _HAGL_HAL_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <hagl/bitmap.h>
+#include <hagl/color.h>
+
+#ifndef HAGL_HAL_BLIT_CACHE_SIZE
+#define HAGL_HAL_BLIT_CACHE_SIZE    (4096)
+#endif
+#ifndef HAGL_HAL_BLIT_CACHE_ENTRIES
+#define HAGL_HAL_BLIT_CACHE_ENTRIES (32)
+#endif
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t used;
+} hagl_hal_cache_stats_t;
+
+/**
+ * Draw a cached tile
+ *
+ * Returns false if tile is not in cache. Caller should then render the
+ * tile and pass it to hagl_hal_cache_put().
+ */
+bool hagl_hal_cache_blit(int16_t x0, int16_t y0, const void *id, hagl_color_t color, hagl_color_t background);
+
+/**
+ * Store a tile in cache and draw it
+ *
+ * Id must not be NULL.
+ */
+void hagl_hal_cache_put(int16_t x0, int16_t y0, const void *id, hagl_color_t color, hagl_color_t background, hagl_bitmap_t *src);
+
+/**
+ * Get hit, miss and eviction counters and number of bytes in use
+ */
+void hagl_hal_cache_stats(hagl_hal_cache_stats_t *stats);
+
+/**
+ * Evict all tiles and reset the counters
+ */
+void hagl_hal_cache_clear();
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _HAGL_HAL_CACHE_H */
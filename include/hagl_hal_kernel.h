@@ -0,0 +1,100 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Pixel kernels used by the backends. When compiled with HAGL_HAL_USE_DSP
+for a core which has the RISC-V packed SIMD extension some of these use
+the DSP intrinsics from Nuclei SDK. Otherwise portable C versions are
+used. Both give bit exact results.
+
+Pixels are RGB565 in the byte order they are sent to the display.
+
+*/
+
+#ifndef _HAGL_HAL_KERNEL_H
+#define _HAGL_HAL_KERNEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "hagl_hal_color.h"
+
+/**
+ * Fill count pixels with color
+ */
+void hagl_hal_kernel_fill(hagl_color_t *dst, hagl_color_t color, size_t count);
+
+/**
+ * Fill count pixels with color, advancing pitch bytes after each pixel
+ */
+void hagl_hal_kernel_fill_column(hagl_color_t *dst, size_t pitch, hagl_color_t color, size_t count);
+
+/**
+ * Copy count pixels
+ */
+void hagl_hal_kernel_copy(hagl_color_t *dst, const hagl_color_t *src, size_t count);
+
+/**
+ * Copy count pixels skipping the ones which have the key color
+ */
+void hagl_hal_kernel_copy_key(hagl_color_t *dst, const hagl_color_t *src, size_t count, hagl_color_t key);
+
+/**
+ * Convert count RGB888 pixels to RGB565 using 4x4 ordered dithering
+ *
+ * The x0 and y0 are screen coordinates of the first pixel. They are
+ * needed to pick the correct cell of the dither matrix.
+ */
+void hagl_hal_kernel_rgb888_to_rgb565(hagl_color_t *dst, const uint8_t *src, size_t count, uint16_t x0, uint16_t y0);
+
+/**
+ * Blend count pixels from src into dst with 50% opacity
+ */
+void hagl_hal_kernel_blend50(hagl_color_t *dst, const hagl_color_t *src, size_t count);
+
+/**
+ * Convert one RGB888 color to RGB565 through a WRITE_LUT style table
+ *
+ * Table has 32 red, 64 green and 32 blue entries with 6 bit values.
+ * Red and blue are truncated to 5 bits, so they can differ from the
+ * panel output by one 6 bit step.
+ */
+hagl_color_t hagl_hal_kernel_rgb888_lut(const uint8_t *lut, uint8_t r, uint8_t g, uint8_t b);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _HAGL_HAL_KERNEL_H */
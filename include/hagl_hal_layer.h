@@ -0,0 +1,115 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Layer compositor used when HAGL_HAL_USE_LAYERS is defined. Application
+registers bitmaps as layers. On flush the layers are composed scanline
+by scanline into two line buffers which are sent to the display with
+DMA. No full size back buffer is needed.
+
+*/
+
+#ifndef _HAGL_HAL_LAYER_H
+#define _HAGL_HAL_LAYER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <hagl/bitmap.h>
+#include <hagl/color.h>
+
+#ifndef HAGL_HAL_LAYER_COUNT
+#define HAGL_HAL_LAYER_COUNT        (4)
+#endif
+
+#define HAGL_HAL_LAYER_VISIBLE      (1 << 0)
+#define HAGL_HAL_LAYER_COLOR_KEY    (1 << 1)
+#define HAGL_HAL_LAYER_MASK         (1 << 2)
+
+typedef struct {
+    hagl_bitmap_t *bitmap;
+    int16_t x0;
+    int16_t y0;
+    /* 1-bit alpha, MSB first, each row padded to full byte. */
+    const uint8_t *mask;
+    hagl_color_t key;
+    uint8_t flags;
+} hagl_hal_layer_t;
+
+/**
+ * Add a bitmap as the topmost free layer
+ *
+ * Layers are composed in the order of their index, lowest first.
+ * Returns the layer index or -1 if all layers are in use. Functions
+ * below ignore indexes which are not below HAGL_HAL_LAYER_COUNT.
+ */
+int8_t hagl_hal_layer_add(hagl_bitmap_t *bitmap, int16_t x0, int16_t y0);
+
+/**
+ * Remove a layer and free its index for reuse
+ */
+void hagl_hal_layer_remove(uint8_t layer);
+
+/**
+ * Move a layer to a new position on screen
+ */
+void hagl_hal_layer_move(uint8_t layer, int16_t x0, int16_t y0);
+
+/**
+ * Pixels of given color will be transparent
+ */
+void hagl_hal_layer_color_key(uint8_t layer, hagl_color_t key);
+
+/**
+ * Pixels with cleared bit in the mask will be transparent. Pass NULL
+ * to disable the mask.
+ */
+void hagl_hal_layer_mask(uint8_t layer, const uint8_t *mask);
+
+/**
+ * Show or hide a layer
+ */
+void hagl_hal_layer_visible(uint8_t layer, bool visible);
+
+/**
+ * Set the layer which HAGL drawing functions draw into
+ */
+void hagl_hal_layer_select(uint8_t layer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _HAGL_HAL_LAYER_H */
@@ -0,0 +1,112 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Mirror flushed frames to a byte sink for remote viewing. Only changed
+rows are encoded. Rows are compressed with RLE into a bounded ring
+buffer which is drained to the sink without ever blocking. Frames
+larger than the ring are sent in chunks. If the sink does not keep up
+the rows which did not fit are merged into one of the next frames.
+
+Stream is a sequence of frames. All 16-bit values are little endian.
+
+    'H' 'M' width height rows {y tokens}
+
+Frame can be preceded by chunks which start with 'H' 'C' instead. They
+carry rows of the same frame which is complete only after the 'H' 'M'.
+
+Each row is width pixels encoded as tokens. Token with high bit set is
+a run of (token & 0x7F) + 1 copies of the following pixel. Otherwise it
+is followed by token + 1 literal pixels.
+
+*/
+
+#ifndef _HAGL_HAL_MIRROR_H
+#define _HAGL_HAL_MIRROR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <hagl/color.h>
+
+/* Must be power of two. */
+#ifndef HAGL_HAL_MIRROR_BUFFER_SIZE
+#define HAGL_HAL_MIRROR_BUFFER_SIZE (4096)
+#endif
+
+/* Non blocking. Returns number of bytes accepted, can be zero. */
+typedef size_t (*hagl_hal_mirror_sink_t)(void *context, const uint8_t *data, size_t size);
+
+typedef struct {
+    uint32_t frames;
+    /* Frames which were cut because the sink was too slow. */
+    uint32_t dropped;
+    uint32_t raw_bytes;
+    uint32_t encoded_bytes;
+} hagl_hal_mirror_stats_t;
+
+/**
+ * Start mirroring to the given sink. NULL sink stops mirroring.
+ */
+void hagl_hal_mirror_init(hagl_hal_mirror_sink_t sink, void *context);
+
+/**
+ * Send all rows with the next frame, for example when viewer connects
+ */
+void hagl_hal_mirror_refresh();
+
+/**
+ * Encode a frame row by row. Called by the backend on flush.
+ */
+void hagl_hal_mirror_begin(uint16_t width, uint16_t height);
+void hagl_hal_mirror_row(uint16_t y, const hagl_color_t *pixels);
+void hagl_hal_mirror_end();
+
+/**
+ * Send as much of the buffered frames to the sink as it accepts
+ */
+void hagl_hal_mirror_drain();
+
+/**
+ * Get frame and drop counters. Compression ratio is raw_bytes divided
+ * by encoded_bytes.
+ */
+void hagl_hal_mirror_stats(hagl_hal_mirror_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _HAGL_HAL_MIRROR_H */
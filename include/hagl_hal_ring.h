@@ -0,0 +1,117 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Lock-free multi producer submission ring for RTOS builds. Several tasks
+can submit drawing commands without a mutex. One display owner task
+drains the ring and executes the commands with the HAL backend. Adjacent
+commands are merged before they are executed.
+
+Each producer must use its own producer id. Commands from one producer
+are executed in the order they were submitted. Bitmaps passed with blit
+commands must stay valid until the ring has been drained.
+
+*/
+
+#ifndef _HAGL_HAL_RING_H
+#define _HAGL_HAL_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <hagl/backend.h>
+#include <hagl/bitmap.h>
+#include <hagl/color.h>
+
+/* Must be power of two. */
+#ifndef HAGL_HAL_RING_SIZE
+#define HAGL_HAL_RING_SIZE          (64)
+#endif
+#ifndef HAGL_HAL_RING_PRODUCERS
+#define HAGL_HAL_RING_PRODUCERS     (4)
+#endif
+
+#define HAGL_HAL_RING_PUT_PIXEL     (0)
+#define HAGL_HAL_RING_HLINE         (1)
+#define HAGL_HAL_RING_VLINE         (2)
+#define HAGL_HAL_RING_BLIT          (3)
+#define HAGL_HAL_RING_FLUSH         (4)
+
+typedef struct {
+    uint8_t type;
+    uint8_t producer;
+    uint16_t sequence;
+    int16_t x0;
+    int16_t y0;
+    /* Width of hline or height of vline. */
+    uint16_t length;
+    hagl_color_t color;
+    hagl_bitmap_t *bitmap;
+} hagl_hal_command_t;
+
+typedef struct {
+    uint32_t executed;
+    uint32_t merged;
+    uint32_t full;
+    uint32_t out_of_order;
+} hagl_hal_ring_stats_t;
+
+/**
+ * Submit a command to the ring
+ *
+ * Safe to call from several tasks at the same time. Returns false if
+ * the ring is full or producer is not below HAGL_HAL_RING_PRODUCERS.
+ */
+bool hagl_hal_ring_submit(uint8_t producer, const hagl_hal_command_t *command);
+
+/**
+ * Execute all submitted commands
+ *
+ * Must be called from one task only. Returns number of commands
+ * executed after merging.
+ */
+size_t hagl_hal_ring_drain(hagl_backend_t *backend);
+
+/**
+ * Get number of executed, merged and rejected commands
+ */
+void hagl_hal_ring_stats(hagl_hal_ring_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _HAGL_HAL_RING_H */
@@ -0,0 +1,66 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Precompiled DCS command stream. Streams are generated at build time with
+tools/dcs_compile.c and played with mipi_display_play(). All multibyte
+values are little endian.
+
+    0x00                            end of stream
+    0x01 command count data         command with count parameter bytes
+    0x02 ms                         delay, 16 bits
+    0x03 x y w h                    set address window, 16 bits each
+    0x04 size data                  pixel data, 32 bit size
+    0x05 count pixel                count copies of one pixel, 32 bit count
+
+Pixels are RGB565 in the byte order they are sent to the display.
+
+*/
+
+#ifndef _MIPI_DCS_STREAM_H
+#define _MIPI_DCS_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MIPI_DCS_STREAM_END                 0x00
+#define MIPI_DCS_STREAM_COMMAND             0x01
+#define MIPI_DCS_STREAM_DELAY               0x02
+#define MIPI_DCS_STREAM_WINDOW              0x03
+#define MIPI_DCS_STREAM_PIXELS              0x04
+#define MIPI_DCS_STREAM_FILL                0x05
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _MIPI_DCS_STREAM_H */
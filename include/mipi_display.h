@@ -40,20 +40,170 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include "hagl_hal.h"
 
+/* 32 red, 64 green and 32 blue entries with 6 bit values. */
+#define MIPI_DISPLAY_LUT_SIZE       (128)
+
+/* Transfer paths chosen by mipi_display_stream(). */
+#define MIPI_DISPLAY_TRANSFER_POLLED        (0)
+#define MIPI_DISPLAY_TRANSFER_INTERRUPT     (1)
+#define MIPI_DISPLAY_TRANSFER_DMA           (2)
+#define MIPI_DISPLAY_TRANSFER_NONE          (0xff)
+
 typedef struct {
-    uint8_t command;
-    uint8_t data[16];
-    uint8_t count;
-} mipi_init_command_t;
+    uint32_t transfers[3];
+    uint32_t bytes[3];
+    /* Path of the latest transfer or MIPI_DISPLAY_TRANSFER_NONE. */
+    uint8_t last;
+} mipi_display_transfer_stats_t;
 
 void mipi_display_init();
 void mipi_display_write(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uint8_t *buffer);
+
+/**
+ * Set the address window and start writing to display memory
+ *
+ * Pixels are then sent with one or more mipi_display_stream() calls.
+ */
+void mipi_display_begin(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h);
+
+/**
+ * Send pixels to the address window set by mipi_display_begin()
+ *
+ * Small transfers are polled and large ones are sent with DMA. With
+ * MIPI_DISPLAY_TRANSFER_USE_INTERRUPT medium ones are sent from the SPI
+ * interrupt if interrupts are enabled. Interrupt and DMA transfers are
+ * asynchronous. Buffer must stay untouched until the next
+ * mipi_display_stream() or mipi_display_wait() call.
+ */
+void mipi_display_stream(const uint8_t *buffer, size_t size);
+
+/**
+ * Send pixels with DMA regardless of size
+ *
+ * For callers which fill one buffer while the other one is being sent.
+ * Buffer must stay untouched until the next mipi_display_stream() or
+ * mipi_display_wait() call.
+ */
+void mipi_display_stream_async(const uint8_t *buffer, size_t size);
+
+/**
+ * Finish writing a frame started with mipi_display_begin()
+ */
+void mipi_display_end();
+
+/**
+ * Wait until pending interrupt or DMA transfer has finished
+ */
+void mipi_display_wait();
 void mipi_display_ioctl(uint8_t command, uint8_t *data, size_t size);
 void mipi_display_close();
 
+/**
+ * Change the panel refresh rate
+ *
+ * Returns the nominal refresh rate which was actually set. Returns
+ * zero if the controller does not support changing the refresh rate.
+ */
+uint16_t mipi_display_set_refresh_rate(uint16_t hz);
+
+/**
+ * Load color correction lookup table
+ *
+ * Returns true if the panel applies the table. Otherwise it is applied
+ * in software by mipi_display_color(), which is also the color function
+ * of the HAGL backend, and by mipi_display_color_apply(). Software red
+ * and blue are truncated to 5 bits. NULL restores the identity table.
+ */
+bool mipi_display_set_lut(const uint8_t *lut);
+
+/**
+ * Select one of the predefined gamma curves 0x01, 0x02, 0x04 or 0x08
+ *
+ * Returns false if the controller does not support it.
+ */
+bool mipi_display_set_gamma_curve(uint8_t curve);
+
+/**
+ * Set display brightness
+ *
+ * Returns false if the controller does not support it.
+ */
+bool mipi_display_set_brightness(uint8_t brightness);
+
+/**
+ * Enter partial mode where only rows y1 to y2 are scanned
+ *
+ * Flush sends only the active rows. Rows are scan lines of the panel
+ * so this assumes the address mode does not swap x and y.
+ */
+void mipi_display_partial_mode(uint16_t y1, uint16_t y2);
+
+/**
+ * Leave partial mode
+ *
+ * With back buffer the panel switches to normal mode only after the
+ * next flush of the whole screen so that stale rows are never shown.
+ */
+void mipi_display_normal_mode();
+
+/**
+ * Enter or leave the 8 color idle mode
+ */
+void mipi_display_idle_mode(bool idle);
+
+/**
+ * Get the rows which are currently scanned
+ */
+void mipi_display_active_rows(uint16_t *y1, uint16_t *y2);
+
+/**
+ * Find the fastest reliable SPI clock for pixel data
+ *
+ * Sends a row of test pattern with DMA at increasing clock and verifies
+ * it by reading the display memory back with the slower read clock. Needs
+ * MIPI_DISPLAY_PIN_MISO which must differ from MIPI_DISPLAY_PIN_CLK.
+ * Returns the SPI prescaler which is used from now on.
+ */
+uint32_t mipi_display_calibrate();
+
+/**
+ * Get the SPI prescaler used for pixel data
+ */
+uint32_t mipi_display_get_pixel_prescale();
+
+/**
+ * Measure the cost of each transfer path and set the size thresholds
+ *
+ * Returns the size in bytes from which DMA is used.
+ */
+size_t mipi_display_calibrate_transfer();
+
+/**
+ * Get how many transfers and bytes went through each path
+ */
+void mipi_display_transfer_stats(mipi_display_transfer_stats_t *stats);
+
+/**
+ * Play a precompiled DCS command stream, see mipi_dcs_stream.h
+ *
+ * Pixel data is sent straight from the stream without copying.
+ */
+void mipi_display_play(const uint8_t *stream);
+
+/**
+ * Convert RGB888 to RGB565 applying software color correction if needed
+ */
+hagl_color_t mipi_display_color(uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * Apply software color correction to pixels if needed
+ */
+void mipi_display_color_apply(hagl_color_t *buffer, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
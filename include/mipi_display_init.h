@@ -0,0 +1,285 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Per controller init tables. What mipi_display_init() sends from them is
+captured on the host and compared against the hand written streams in
+tools/golden, see tools/init_check.sh. Includer must define the display
+config first.
+
+*/
+
+#ifndef _MIPI_DISPLAY_INIT_H
+#define _MIPI_DISPLAY_INIT_H
+
+#include <stdint.h>
+
+#include "mipi_dcs.h"
+#include "mipi_vendor.h"
+
+#define MIPI_INIT_COMMAND_MAX_DATA  (32)
+
+typedef struct {
+    uint8_t command;
+    uint8_t data[MIPI_INIT_COMMAND_MAX_DATA];
+    uint8_t count;
+} mipi_init_command_t;
+
+#ifndef MIPI_DISPLAY_INIT_STREAM
+static const uint8_t DELAY_BIT = 1 << 7;
+static const uint8_t COUNT_MASK = 0x7F;
+#endif /* MIPI_DISPLAY_INIT_STREAM */
+
+#ifdef MIPI_DISPLAY_INVERT
+#define MIPI_DISPLAY_INVERT_COMMAND     (MIPI_DCS_ENTER_INVERT_MODE)
+#else
+#define MIPI_DISPLAY_INVERT_COMMAND     (MIPI_DCS_EXIT_INVERT_MODE)
+#endif
+
+#if MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_ST7735
+
+/* Frame rate = fosc / ((RTNA * 2 + 40) * (LINES + FPA + BPA + 2)) */
+#define ST7735_FOSC         (850000)
+#define ST7735_LINES        (160)
+#define ST7735_FPA          (0x2C)
+#define ST7735_BPA          (0x2D)
+#define ST7735_RTNA         (0x01)
+
+#ifndef MIPI_DISPLAY_INIT_STREAM
+static const mipi_init_command_t init_commands[] = {
+    {MIPI_DCS_SOFT_RESET, {0}, 0 | DELAY_BIT},
+    {MIPI_DCS_EXIT_SLEEP_MODE, {0}, 0 | DELAY_BIT},
+    {ST7735_FRMCTR1, {ST7735_RTNA, ST7735_FPA, ST7735_BPA}, 3},
+    {ST7735_FRMCTR2, {ST7735_RTNA, ST7735_FPA, ST7735_BPA}, 3},
+    {ST7735_FRMCTR3, {ST7735_RTNA, ST7735_FPA, ST7735_BPA, ST7735_RTNA, ST7735_FPA, ST7735_BPA}, 6},
+    {ST7735_INVCTR, {0x07}, 1},
+    {ST7735_PWCTR1, {0xA2, 0x02, 0x84}, 3},
+    {ST7735_PWCTR2, {0xC5}, 1},
+    {ST7735_PWCTR3, {0x0A, 0x00}, 2},
+    {ST7735_PWCTR4, {0x8A, 0x2A}, 2},
+    {ST7735_PWCTR5, {0x8A, 0xEE}, 2},
+    {ST7735_VMCTR1, {0x0E}, 1},
+    {MIPI_DCS_SET_ADDRESS_MODE, {MIPI_DISPLAY_ADDRESS_MODE}, 1},
+    {MIPI_DCS_SET_PIXEL_FORMAT, {MIPI_DISPLAY_PIXEL_FORMAT}, 1},
+    {MIPI_DISPLAY_INVERT_COMMAND, {0}, 0},
+    {ST7735_GMCTRP1, {
+            0x02, 0x1C, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2D,
+            0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10
+        }, 16
+    },
+    {ST7735_GMCTRN1, {
+            0x03, 0x1D, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D,
+            0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10
+        }, 16
+    },
+    {MIPI_DCS_ENTER_NORMAL_MODE, {0}, 0},
+    {MIPI_DCS_SET_DISPLAY_ON, {0}, 0 | DELAY_BIT},
+    /* End of commands . */
+    {0, {0}, 0xff},
+};
+#endif /* MIPI_DISPLAY_INIT_STREAM */
+
+#elif MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_ST7789
+
+/* Frame rate = fosc / ((320 + FPA + BPA) * (250 + RTNA * 16)) */
+#define ST7789_FOSC         (10000000)
+#define ST7789_FPA          (0x0C)
+#define ST7789_BPA          (0x0C)
+#define ST7789_RTNA         (0x0F)
+
+#ifndef MIPI_DISPLAY_INIT_STREAM
+static const mipi_init_command_t init_commands[] = {
+    {MIPI_DCS_SOFT_RESET, {0}, 0 | DELAY_BIT},
+    {MIPI_DCS_EXIT_SLEEP_MODE, {0}, 0 | DELAY_BIT},
+    {MIPI_DCS_SET_ADDRESS_MODE, {MIPI_DISPLAY_ADDRESS_MODE}, 1},
+    {MIPI_DCS_SET_PIXEL_FORMAT, {MIPI_DISPLAY_PIXEL_FORMAT}, 1},
+    {ST7789_PORCTRL, {ST7789_BPA, ST7789_FPA, 0x00, 0x33, 0x33}, 5},
+    {ST7789_GCTRL, {0x35}, 1},
+    {ST7789_VCOMS, {0x28}, 1},
+    {ST7789_LCMCTRL, {0x0C}, 1},
+    {ST7789_VDVVRHEN, {0x01, 0xFF}, 2},
+    {ST7789_VRHS, {0x10}, 1},
+    {ST7789_VDVS, {0x20}, 1},
+    {ST7789_FRCTRL2, {ST7789_RTNA}, 1},
+    {ST7789_PWCTRL1, {0xA4, 0xA1}, 2},
+    {ST7789_PVGAMCTRL, {
+            0xD0, 0x00, 0x02, 0x07, 0x0A, 0x28, 0x32, 0x44,
+            0x42, 0x06, 0x0E, 0x12, 0x14, 0x17
+        }, 14
+    },
+    {ST7789_NVGAMCTRL, {
+            0xD0, 0x00, 0x02, 0x07, 0x0A, 0x28, 0x31, 0x54,
+            0x47, 0x0E, 0x1C, 0x17, 0x1B, 0x1E
+        }, 14
+    },
+    {MIPI_DISPLAY_INVERT_COMMAND, {0}, 0},
+    {MIPI_DCS_ENTER_NORMAL_MODE, {0}, 0},
+    {MIPI_DCS_SET_DISPLAY_ON, {0}, 0 | DELAY_BIT},
+    /* End of commands . */
+    {0, {0}, 0xff},
+};
+#endif /* MIPI_DISPLAY_INIT_STREAM */
+
+#elif MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_ILI9341
+
+/* Frame rate = fosc / (2^DIVA * RTNA * (320 + VFP + VBP)) */
+#define ILI9341_FOSC        (615000)
+#define ILI9341_VFP         (0x02)
+#define ILI9341_VBP         (0x02)
+#define ILI9341_DIVA        (0x00)
+#define ILI9341_RTNA        (0x18)
+
+#ifndef MIPI_DISPLAY_INIT_STREAM
+static const mipi_init_command_t init_commands[] = {
+    {MIPI_DCS_SOFT_RESET, {0}, 0 | DELAY_BIT},
+    {ILI9341_PWCTRB, {0x00, 0xC1, 0x30}, 3},
+    {ILI9341_PWRSEQ, {0x64, 0x03, 0x12, 0x81}, 4},
+    {ILI9341_DTCTRA, {0x85, 0x00, 0x78}, 3},
+    {ILI9341_PWCTRA, {0x39, 0x2C, 0x00, 0x34, 0x02}, 5},
+    {ILI9341_PUMPRC, {0x20}, 1},
+    {ILI9341_DTCTRB, {0x00, 0x00}, 2},
+    {ILI9341_PWCTR1, {0x23}, 1},
+    {ILI9341_PWCTR2, {0x10}, 1},
+    {ILI9341_VMCTR1, {0x3E, 0x28}, 2},
+    {ILI9341_VMCTR2, {0x86}, 1},
+    {MIPI_DCS_SET_ADDRESS_MODE, {MIPI_DISPLAY_ADDRESS_MODE}, 1},
+    {MIPI_DCS_SET_PIXEL_FORMAT, {MIPI_DISPLAY_PIXEL_FORMAT}, 1},
+    {ILI9341_FRMCTR1, {ILI9341_DIVA, ILI9341_RTNA}, 2},
+    {ILI9341_DFUNCTR, {0x08, 0x82, 0x27}, 3},
+    {ILI9341_ENABLE3G, {0x00}, 1},
+    {MIPI_DCS_SET_GAMMA_CURVE, {0x01}, 1},
+    {ILI9341_GMCTRP1, {
+            0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+            0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00
+        }, 15
+    },
+    {ILI9341_GMCTRN1, {
+            0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+            0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F
+        }, 15
+    },
+    {MIPI_DISPLAY_INVERT_COMMAND, {0}, 0},
+    {MIPI_DCS_EXIT_SLEEP_MODE, {0}, 0 | DELAY_BIT},
+    {MIPI_DCS_SET_DISPLAY_ON, {0}, 0 | DELAY_BIT},
+    /* End of commands . */
+    {0, {0}, 0xff},
+};
+#endif /* MIPI_DISPLAY_INIT_STREAM */
+
+#elif MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_GC9A01
+
+/* Frame rate register is set to the vendor recommended value. Its */
+/* formula is not documented so refresh rate cannot be changed. */
+#ifndef MIPI_DISPLAY_INIT_STREAM
+static const mipi_init_command_t init_commands[] = {
+    {MIPI_DCS_SOFT_RESET, {0}, 0 | DELAY_BIT},
+    {GC9A01_INREGEN2, {0}, 0},
+    {0xEB, {0x14}, 1},
+    {GC9A01_INREGEN1, {0}, 0},
+    {GC9A01_INREGEN2, {0}, 0},
+    {0xEB, {0x14}, 1},
+    {0x84, {0x40}, 1},
+    {0x85, {0xFF}, 1},
+    {0x86, {0xFF}, 1},
+    {0x87, {0xFF}, 1},
+    {0x88, {0x0A}, 1},
+    {0x89, {0x21}, 1},
+    {0x8A, {0x00}, 1},
+    {0x8B, {0x80}, 1},
+    {0x8C, {0x01}, 1},
+    {0x8D, {0x01}, 1},
+    {0x8E, {0xFF}, 1},
+    {0x8F, {0xFF}, 1},
+    {GC9A01_DFUNCTR, {0x00, 0x20}, 2},
+    {MIPI_DCS_SET_ADDRESS_MODE, {MIPI_DISPLAY_ADDRESS_MODE}, 1},
+    {MIPI_DCS_SET_PIXEL_FORMAT, {MIPI_DISPLAY_PIXEL_FORMAT}, 1},
+    {0x90, {0x08, 0x08, 0x08, 0x08}, 4},
+    {0xBD, {0x06}, 1},
+    {0xBC, {0x00}, 1},
+    {0xFF, {0x60, 0x01, 0x04}, 3},
+    {GC9A01_POWER2, {0x13}, 1},
+    {GC9A01_POWER3, {0x13}, 1},
+    {GC9A01_POWER4, {0x22}, 1},
+    {0xBE, {0x11}, 1},
+    {0xE1, {0x10, 0x0E}, 2},
+    {0xDF, {0x21, 0x0C, 0x02}, 3},
+    {GC9A01_GAMMA1, {0x45, 0x09, 0x08, 0x08, 0x26, 0x2A}, 6},
+    {GC9A01_GAMMA2, {0x43, 0x70, 0x72, 0x36, 0x37, 0x6F}, 6},
+    {GC9A01_GAMMA3, {0x45, 0x09, 0x08, 0x08, 0x26, 0x2A}, 6},
+    {GC9A01_GAMMA4, {0x43, 0x70, 0x72, 0x36, 0x37, 0x6F}, 6},
+    {0xED, {0x1B, 0x0B}, 2},
+    {0xAE, {0x77}, 1},
+    {0xCD, {0x63}, 1},
+    {0x70, {0x07, 0x07, 0x04, 0x0E, 0x0F, 0x09, 0x07, 0x08, 0x03}, 9},
+    {GC9A01_FRAMERATE, {0x34}, 1},
+    {0x62, {
+            0x18, 0x0D, 0x71, 0xED, 0x70, 0x70,
+            0x18, 0x0F, 0x71, 0xEF, 0x70, 0x70
+        }, 12
+    },
+    {0x63, {
+            0x18, 0x11, 0x71, 0xF1, 0x70, 0x70,
+            0x18, 0x13, 0x71, 0xF3, 0x70, 0x70
+        }, 12
+    },
+    {0x64, {0x28, 0x29, 0xF1, 0x01, 0xF1, 0x00, 0x07}, 7},
+    {0x66, {0x3C, 0x00, 0xCD, 0x67, 0x45, 0x45, 0x10, 0x00, 0x00, 0x00}, 10},
+    {0x67, {0x00, 0x3C, 0x00, 0x00, 0x00, 0x01, 0x54, 0x10, 0x32, 0x98}, 10},
+    {0x74, {0x10, 0x85, 0x80, 0x00, 0x00, 0x4E, 0x00}, 7},
+    {0x98, {0x3E, 0x07}, 2},
+    {MIPI_DCS_SET_TEAR_ON, {0x00}, 1},
+    {MIPI_DISPLAY_INVERT_COMMAND, {0}, 0},
+    {MIPI_DCS_EXIT_SLEEP_MODE, {0}, 0 | DELAY_BIT},
+    {MIPI_DCS_SET_DISPLAY_ON, {0}, 0 | DELAY_BIT},
+    /* End of commands . */
+    {0, {0}, 0xff},
+};
+#endif /* MIPI_DISPLAY_INIT_STREAM */
+
+#else
+
+#ifndef MIPI_DISPLAY_INIT_STREAM
+static const mipi_init_command_t init_commands[] = {
+    {MIPI_DCS_SOFT_RESET, {0}, 0 | DELAY_BIT},
+    {MIPI_DCS_SET_ADDRESS_MODE, {MIPI_DISPLAY_ADDRESS_MODE}, 1},
+    {MIPI_DCS_SET_PIXEL_FORMAT, {MIPI_DISPLAY_PIXEL_FORMAT}, 1},
+    {MIPI_DISPLAY_INVERT_COMMAND, {0}, 0},
+    {MIPI_DCS_EXIT_SLEEP_MODE, {0}, 0 | DELAY_BIT},
+    {MIPI_DCS_SET_DISPLAY_ON, {0}, 0 | DELAY_BIT},
+    /* End of commands . */
+    {0, {0}, 0xff},
+};
+#endif /* MIPI_DISPLAY_INIT_STREAM */
+
+#endif
+
+#endif /* _MIPI_DISPLAY_INIT_H */
@@ -0,0 +1,103 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Video and animation playback. Frames are read by a source callback into
+one of two DMA buffers while the other one is being sent to the display.
+Pixels are never copied into a bitmap.
+
+Clip is a sequence of frames. Each frame starts with a type byte. All
+16-bit values are little endian.
+
+    0x00                            unchanged frame, nothing follows
+    0x01 pixels                     full frame, width * height pixels
+    0x02 count {y rows pixels}      count runs of changed rows, each run
+                                    has y, number of rows and the pixels,
+                                    empty runs are skipped
+
+*/
+
+#ifndef _MIPI_DISPLAY_VIDEO_H
+#define _MIPI_DISPLAY_VIDEO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef MIPI_DISPLAY_VIDEO_BUFFER_SIZE
+#define MIPI_DISPLAY_VIDEO_BUFFER_SIZE  (2048)
+#endif
+
+#define MIPI_DISPLAY_VIDEO_UNCHANGED    (0x00)
+#define MIPI_DISPLAY_VIDEO_FULL         (0x01)
+#define MIPI_DISPLAY_VIDEO_ROWS         (0x02)
+
+typedef struct {
+    /* Read size bytes. Returning less than size ends the playback. */
+    size_t (*read)(void *context, uint8_t *buffer, size_t size);
+    /* Optional. Skip size bytes without reading them. */
+    size_t (*skip)(void *context, size_t size);
+    void *context;
+} mipi_display_video_source_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t unchanged;
+    uint32_t dropped;
+    uint32_t late;
+    uint32_t elapsed_ms;
+    /* Achieved frame rate times 100. */
+    uint32_t fps_x100;
+} mipi_display_video_stats_t;
+
+/**
+ * Play a clip until the source ends
+ *
+ * Frames are shown in the given window and paced to fps. Full frames
+ * are dropped when playback is more than one frame behind. With zero
+ * fps frames are played as fast as possible and never dropped. Runs of
+ * rows outside of the window, truncated frames and unknown frame types
+ * end the playback. Such frames are not counted. Stats can be NULL.
+ */
+void mipi_display_video_play(
+    const mipi_display_video_source_t *source,
+    uint16_t x0, uint16_t y0, uint16_t width, uint16_t height,
+    uint16_t fps, mipi_display_video_stats_t *stats
+);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _MIPI_DISPLAY_VIDEO_H */
@@ -0,0 +1,116 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Vendor specific commands for the supported display controllers. These
+are outside of the MIPI DCS specification and their meaning varies from
+controller to controller.
+
+*/
+
+#ifndef _MIPI_VENDOR_H
+#define _MIPI_VENDOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Supported display controllers. Generic uses only standard */
+/* MIPI DCS commands and leaves vendor registers to their */
+/* power-on defaults. */
+#define MIPI_DISPLAY_CONTROLLER_GENERIC     (0)
+#define MIPI_DISPLAY_CONTROLLER_ST7735      (1)
+#define MIPI_DISPLAY_CONTROLLER_ST7789      (2)
+#define MIPI_DISPLAY_CONTROLLER_ILI9341     (3)
+#define MIPI_DISPLAY_CONTROLLER_GC9A01      (4)
+
+/* Sitronix ST7735 and ST7735S */
+#define ST7735_FRMCTR1                      0xB1 /* Frame rate in normal mode */
+#define ST7735_FRMCTR2                      0xB2 /* Frame rate in idle mode */
+#define ST7735_FRMCTR3                      0xB3 /* Frame rate in partial mode */
+#define ST7735_INVCTR                       0xB4
+#define ST7735_PWCTR1                       0xC0
+#define ST7735_PWCTR2                       0xC1
+#define ST7735_PWCTR3                       0xC2
+#define ST7735_PWCTR4                       0xC3
+#define ST7735_PWCTR5                       0xC4
+#define ST7735_VMCTR1                       0xC5
+#define ST7735_GMCTRP1                      0xE0
+#define ST7735_GMCTRN1                      0xE1
+
+/* Sitronix ST7789 and ST7789V */
+#define ST7789_PORCTRL                      0xB2 /* Porch setting */
+#define ST7789_GCTRL                        0xB7
+#define ST7789_VCOMS                        0xBB
+#define ST7789_LCMCTRL                      0xC0
+#define ST7789_VDVVRHEN                     0xC2
+#define ST7789_VRHS                         0xC3
+#define ST7789_VDVS                         0xC4
+#define ST7789_FRCTRL2                      0xC6 /* Frame rate in normal mode */
+#define ST7789_PWCTRL1                      0xD0
+#define ST7789_PVGAMCTRL                    0xE0
+#define ST7789_NVGAMCTRL                    0xE1
+
+/* Ilitek ILI9341 */
+#define ILI9341_FRMCTR1                     0xB1 /* Frame rate in normal mode */
+#define ILI9341_DFUNCTR                     0xB6
+#define ILI9341_PWCTR1                      0xC0
+#define ILI9341_PWCTR2                      0xC1
+#define ILI9341_VMCTR1                      0xC5
+#define ILI9341_VMCTR2                      0xC7
+#define ILI9341_PWCTRA                      0xCB
+#define ILI9341_PWCTRB                      0xCF
+#define ILI9341_GMCTRP1                     0xE0
+#define ILI9341_GMCTRN1                     0xE1
+#define ILI9341_DTCTRA                      0xE8
+#define ILI9341_DTCTRB                      0xEA
+#define ILI9341_PWRSEQ                      0xED
+#define ILI9341_ENABLE3G                    0xF2
+#define ILI9341_PUMPRC                      0xF7
+
+/* Galaxycore GC9A01 */
+#define GC9A01_DFUNCTR                      0xB6
+#define GC9A01_POWER2                       0xC3
+#define GC9A01_POWER3                       0xC4
+#define GC9A01_POWER4                       0xC9
+#define GC9A01_FRAMERATE                    0xE8
+#define GC9A01_INREGEN2                     0xEF
+#define GC9A01_GAMMA1                       0xF0
+#define GC9A01_GAMMA2                       0xF1
+#define GC9A01_GAMMA3                       0xF2
+#define GC9A01_GAMMA4                       0xF3
+#define GC9A01_INREGEN1                     0xFE
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _MIPI_VENDOR_H */
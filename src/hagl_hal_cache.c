@@ -0,0 +1,238 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Blit cache for single buffer mode. Tiles are stored in a static byte
+buffer. Free space is searched first fit from the gaps between cached
+tiles. If nothing fits least recently used tiles are evicted until the
+tile fits.
+
+Tiles are sent with DMA whatever their size. The cache buffer is only
+overwritten after the previous transfer has finished.
+
+*/
+
+#include "hagl_hal.h"
+
+#if defined(HAGL_HAL_USE_SINGLE_BUFFER) && defined(HAGL_HAL_USE_BLIT_CACHE)
+
+#include <string.h>
+#include <stdbool.h>
+
+#include <hagl/bitmap.h>
+#include <hagl/color.h>
+
+#include "mipi_display.h"
+#include "hagl_hal_cache.h"
+
+/* Offsets and sizes of tiles are stored in 16 bits. */
+_Static_assert(HAGL_HAL_BLIT_CACHE_SIZE <= 0xffff, "HAGL_HAL_BLIT_CACHE_SIZE must fit in 16 bits");
+
+typedef struct {
+    const void *id;
+    hagl_color_t color;
+    hagl_color_t background;
+    uint16_t width;
+    uint16_t height;
+    uint16_t offset;
+    uint16_t size;
+    uint32_t used;
+} entry_t;
+
+static uint8_t buffer[HAGL_HAL_BLIT_CACHE_SIZE] __attribute__((aligned(4)));
+static entry_t entries[HAGL_HAL_BLIT_CACHE_ENTRIES];
+static hagl_hal_cache_stats_t stats;
+static uint32_t tick = 0;
+
+static void
+draw(int16_t x0, int16_t y0, entry_t *entry)
+{
+    entry->used = ++tick;
+    mipi_display_begin(x0, y0, entry->width, entry->height);
+    mipi_display_stream_async(&buffer[entry->offset], entry->size);
+    mipi_display_end();
+}
+
+static bool
+overlaps(uint32_t offset, uint32_t size)
+{
+    for (uint8_t i = 0; i < HAGL_HAL_BLIT_CACHE_ENTRIES; i++) {
+        entry_t *entry = &entries[i];
+        if (entry->size
+            && offset < entry->offset + entry->size
+            && entry->offset < offset + size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Returns offset of free space or -1 if there is none. */
+static int32_t
+find_space(uint32_t size)
+{
+    if (!overlaps(0, size)) {
+        return 0;
+    }
+
+    /* Gaps can only start where some tile ends. */
+    for (uint8_t i = 0; i < HAGL_HAL_BLIT_CACHE_ENTRIES; i++) {
+        uint32_t offset = entries[i].offset + entries[i].size;
+        if (entries[i].size
+            && offset + size <= HAGL_HAL_BLIT_CACHE_SIZE
+            && !overlaps(offset, size)) {
+            return offset;
+        }
+    }
+    return -1;
+}
+
+static entry_t *
+evict_lru()
+{
+    entry_t *lru = NULL;
+
+    for (uint8_t i = 0; i < HAGL_HAL_BLIT_CACHE_ENTRIES; i++) {
+        if (entries[i].size && (!lru || entries[i].used < lru->used)) {
+            lru = &entries[i];
+        }
+    }
+
+    if (lru) {
+        stats.used -= lru->size;
+        stats.evictions++;
+        lru->size = 0;
+    }
+
+    return lru;
+}
+
+static entry_t *
+find_entry()
+{
+    for (uint8_t i = 0; i < HAGL_HAL_BLIT_CACHE_ENTRIES; i++) {
+        if (!entries[i].size) {
+            return &entries[i];
+        }
+    }
+
+    /* No free slot, evict least recently used tile. */
+    return evict_lru();
+}
+
+bool
+hagl_hal_cache_blit(int16_t x0, int16_t y0, const void *id, hagl_color_t color, hagl_color_t background)
+{
+    for (uint8_t i = 0; i < HAGL_HAL_BLIT_CACHE_ENTRIES; i++) {
+        entry_t *entry = &entries[i];
+        if (entry->size
+            && entry->id == id
+            && entry->color == color
+            && entry->background == background) {
+            stats.hits++;
+            draw(x0, y0, entry);
+            return true;
+        }
+    }
+
+    stats.misses++;
+    return false;
+}
+
+static entry_t *
+store(hagl_bitmap_t *src, uint32_t size)
+{
+    uint32_t pitch = src->width * sizeof(hagl_color_t);
+    int32_t offset;
+
+    entry_t *entry = find_entry();
+
+    while (-1 == (offset = find_space(size))) {
+        evict_lru();
+    }
+
+    /* DMA might still be reading the evicted tile. */
+    mipi_display_wait();
+
+    for (uint16_t y = 0; y < src->height; y++) {
+        memcpy(&buffer[offset + y * pitch], src->buffer + y * src->pitch, pitch);
+    }
+
+    entry->width = src->width;
+    entry->height = src->height;
+    entry->offset = offset;
+    entry->size = size;
+
+    stats.used += size;
+
+    return entry;
+}
+
+void
+hagl_hal_cache_put(int16_t x0, int16_t y0, const void *id, hagl_color_t color, hagl_color_t background, hagl_bitmap_t *src)
+{
+    uint32_t size = src->width * sizeof(hagl_color_t) * src->height;
+
+    if (0 == size) {
+        return;
+    }
+
+    if (size > HAGL_HAL_BLIT_CACHE_SIZE) {
+        mipi_display_write(x0, y0, src->width, src->height, src->buffer);
+        return;
+    }
+
+    entry_t *entry = store(src, size);
+
+    entry->id = id;
+    entry->color = color;
+    entry->background = background;
+
+    draw(x0, y0, entry);
+}
+
+void
+hagl_hal_cache_stats(hagl_hal_cache_stats_t *dst)
+{
+    memcpy(dst, &stats, sizeof(hagl_hal_cache_stats_t));
+}
+
+void
+hagl_hal_cache_clear()
+{
+    mipi_display_wait();
+    memset(entries, 0, sizeof(entries));
+    memset(&stats, 0, sizeof(stats));
+    tick = 0;
+}
+
+#endif /* HAGL_HAL_USE_SINGLE_BUFFER && HAGL_HAL_USE_BLIT_CACHE */
@@ -51,6 +51,8 @@ assumed to be valid.
 
 #include <mipi_display.h>
 #include <mipi_dcs.h>
+#include <hagl_hal_kernel.h>
+#include <hagl_hal_mirror.h>
 
 #include <hagl/bitmap.h>
 #include <hagl/backend.h>
@@ -61,10 +63,22 @@ static hagl_bitmap_t bb;
 static size_t
 flush(void *self)
 {
-    /* Flush the whole back buffer. */
-    mipi_display_write(0, 0, bb.width, bb.height, (uint8_t *) bb.buffer);
-    /* TODO: should be returned above. */
-    return DISPLAY_WIDTH * DISPLAY_HEIGHT * (DISPLAY_DEPTH / 8);
+    uint16_t y1, y2;
+
+    /* Flush the rows which are scanned, in normal mode the whole back buffer. */
+    mipi_display_active_rows(&y1, &y2);
+    mipi_display_write(0, y1, bb.width, y2 - y1 + 1, (uint8_t *) bb.buffer + y1 * bb.pitch);
+
+#ifdef HAGL_HAL_USE_MIRROR
+    /* Encode while DMA is sending the same rows. */
+    hagl_hal_mirror_begin(bb.width, bb.height);
+    for (uint16_t y = y1; y <= y2; y++) {
+        hagl_hal_mirror_row(y, (hagl_color_t *) (bb.buffer + y * bb.pitch));
+    }
+    hagl_hal_mirror_end();
+#endif /* HAGL_HAL_USE_MIRROR */
+
+    return (y2 - y1 + 1) * bb.pitch;
 }
 
 static void
@@ -94,13 +108,22 @@ scale_blit(void *self, uint16_t x0, uint16_t y0, uint16_t w, uint16_t h, hagl_bi
 static void
 hline(void *self, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
 {
-    bb.hline(&bb, x0, y0, width, color);
+    hagl_color_t *ptr = (hagl_color_t *) (bb.buffer + y0 * bb.pitch) + x0;
+    hagl_hal_kernel_fill(ptr, color, width);
 }
 
 static void
 vline(void *self, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
 {
-    bb.vline(&bb, x0, y0, height, color);
+    hagl_color_t *ptr = (hagl_color_t *) (bb.buffer + y0 * bb.pitch) + x0;
+    hagl_hal_kernel_fill_column(ptr, bb.pitch, color, height);
+}
+
+/* Applies software color correction when the panel has no WRITE_LUT. */
+static hagl_color_t
+color(void *self, uint8_t r, uint8_t g, uint8_t b)
+{
+    return mipi_display_color(r, g, b);
 }
 
 void
@@ -119,6 +142,7 @@ hagl_hal_init(hagl_backend_t *backend)
     backend->height = MIPI_DISPLAY_HEIGHT;
     backend->depth = MIPI_DISPLAY_DEPTH;
     backend->put_pixel = put_pixel;
+    backend->color = color;
     backend->get_pixel = get_pixel;
     backend->hline = hline;
     backend->vline = vline;
@@ -0,0 +1,271 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Pixel kernels with optional RISC-V packed SIMD implementation. The packed
+versions process two pixels per 32-bit word. Words are only used when
+source and destination have the same alignment, otherwise the scalar
+code handles everything. RGB888 conversion saturates four
+pixels, twelve bytes, with three packed adds.
+
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef HAGL_HAL_USE_DSP
+/* SoC header tells whether the core has the P extension. */
+#include "nuclei_sdk_soc.h"
+#if defined(__DSP_PRESENT) && (__DSP_PRESENT == 1)
+#define HAGL_HAL_KERNEL_DSP
+#endif
+#endif /* HAGL_HAL_USE_DSP */
+
+#include "hagl_hal_kernel.h"
+
+/* Two pixels packed into one word. */
+typedef uint32_t __attribute__((__may_alias__)) pair_t;
+
+/* 4x4 Bayer matrix for ordered dithering. */
+static const uint8_t bayer[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+#ifdef HAGL_HAL_KERNEL_DSP
+#define swap8(value) __RV_SWAP8(value)
+#else
+static inline uint32_t
+swap8(uint32_t value)
+{
+    return ((value & 0x00ff00ff) << 8) | ((value >> 8) & 0x00ff00ff);
+}
+#endif /* HAGL_HAL_KERNEL_DSP */
+
+static inline uint8_t
+saturate(uint16_t value)
+{
+    return value > 0xff ? 0xff : value;
+}
+
+static inline hagl_color_t
+blend(hagl_color_t a, hagl_color_t b)
+{
+    uint32_t result;
+
+    a = swap8(a);
+    b = swap8(b);
+    result = (a & b) + (((a ^ b) & 0xF7DE) >> 1);
+
+    return swap8(result);
+}
+
+static inline uint8_t
+same_alignment(const void *a, const void *b)
+{
+    return ((uintptr_t) a & 2) == ((uintptr_t) b & 2);
+}
+
+void
+hagl_hal_kernel_fill(hagl_color_t *dst, hagl_color_t color, size_t count)
+{
+    pair_t pair = color | ((uint32_t) color << 16);
+
+    if (count && ((uintptr_t) dst & 2)) {
+        *(dst++) = color;
+        count--;
+    }
+
+    pair_t *ptr = (pair_t *) dst;
+    while (count >= 2) {
+        *(ptr++) = pair;
+        count -= 2;
+    }
+
+    if (count) {
+        *(hagl_color_t *) ptr = color;
+    }
+}
+
+void
+hagl_hal_kernel_fill_column(hagl_color_t *dst, size_t pitch, hagl_color_t color, size_t count)
+{
+    uint8_t *ptr = (uint8_t *) dst;
+
+    while (count--) {
+        *(hagl_color_t *) ptr = color;
+        ptr += pitch;
+    }
+}
+
+void
+hagl_hal_kernel_copy(hagl_color_t *dst, const hagl_color_t *src, size_t count)
+{
+    memcpy(dst, src, count * sizeof(hagl_color_t));
+}
+
+void
+hagl_hal_kernel_copy_key(hagl_color_t *dst, const hagl_color_t *src, size_t count, hagl_color_t key)
+{
+#ifdef HAGL_HAL_KERNEL_DSP
+    if (same_alignment(dst, src)) {
+        uint32_t keys = key | ((uint32_t) key << 16);
+
+        if (count && ((uintptr_t) dst & 2)) {
+            if (*src != key) {
+                *dst = *src;
+            }
+            dst++;
+            src++;
+            count--;
+        }
+
+        while (count >= 2) {
+            uint32_t pixels = *(const pair_t *) src;
+            /* Lanes matching the key become 0xffff. */
+            uint32_t mask = __RV_CMPEQ16(pixels, keys);
+            *(pair_t *) dst = (pixels & ~mask) | (*(pair_t *) dst & mask);
+            dst += 2;
+            src += 2;
+            count -= 2;
+        }
+    }
+#endif /* HAGL_HAL_KERNEL_DSP */
+
+    while (count--) {
+        if (*src != key) {
+            *dst = *src;
+        }
+        dst++;
+        src++;
+    }
+}
+
+static inline hagl_color_t
+rgb565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return swap8(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+void
+hagl_hal_kernel_rgb888_to_rgb565(hagl_color_t *dst, const uint8_t *src, size_t count, uint16_t x0, uint16_t y0)
+{
+    const uint8_t *row = bayer[y0 & 3];
+
+#ifdef HAGL_HAL_KERNEL_DSP
+    /* Four pixels are twelve bytes, dither repeats every four pixels. */
+    uint8_t bytes[12];
+    uint32_t dither[3];
+
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t d = row[(x0 + i) & 3];
+        bytes[i * 3] = d >> 1;
+        bytes[i * 3 + 1] = d >> 2;
+        bytes[i * 3 + 2] = d >> 1;
+    }
+    memcpy(dither, bytes, sizeof(dither));
+
+    while (count >= 4) {
+        uint32_t rgb[3];
+
+        /* Saturating add of twelve channels in three instructions. */
+        memcpy(rgb, src, sizeof(rgb));
+        rgb[0] = __RV_UKADD8(rgb[0], dither[0]);
+        rgb[1] = __RV_UKADD8(rgb[1], dither[1]);
+        rgb[2] = __RV_UKADD8(rgb[2], dither[2]);
+        memcpy(bytes, rgb, sizeof(bytes));
+
+        dst[0] = rgb565(bytes[0], bytes[1], bytes[2]);
+        dst[1] = rgb565(bytes[3], bytes[4], bytes[5]);
+        dst[2] = rgb565(bytes[6], bytes[7], bytes[8]);
+        dst[3] = rgb565(bytes[9], bytes[10], bytes[11]);
+
+        dst += 4;
+        src += 12;
+        count -= 4;
+    }
+#endif /* HAGL_HAL_KERNEL_DSP */
+
+    /* Groups of four keep the dither phase so x0 is still valid. */
+    for (size_t i = 0; i < count; i++) {
+        uint8_t d = row[(x0 + i) & 3];
+
+        dst[i] = rgb565(
+                     saturate(src[0] + (d >> 1)),
+                     saturate(src[1] + (d >> 2)),
+                     saturate(src[2] + (d >> 1))
+                 );
+        src += 3;
+    }
+}
+
+void
+hagl_hal_kernel_blend50(hagl_color_t *dst, const hagl_color_t *src, size_t count)
+{
+    if (same_alignment(dst, src)) {
+        if (count && ((uintptr_t) dst & 2)) {
+            *dst = blend(*dst, *src);
+            dst++;
+            src++;
+            count--;
+        }
+
+        while (count >= 2) {
+            uint32_t a = swap8(*(pair_t *) dst);
+            uint32_t b = swap8(*(const pair_t *) src);
+            /* Average of each channel, lowest bits masked to avoid bleeding. */
+            *(pair_t *) dst = swap8((a & b) + (((a ^ b) & 0xF7DEF7DE) >> 1));
+            dst += 2;
+            src += 2;
+            count -= 2;
+        }
+    }
+
+    while (count--) {
+        *dst = blend(*dst, *src);
+        dst++;
+        src++;
+    }
+}
+
+hagl_color_t
+hagl_hal_kernel_rgb888_lut(const uint8_t *lut, uint8_t r, uint8_t g, uint8_t b)
+{
+    r = lut[r >> 3] << 2;
+    g = lut[32 + (g >> 2)] << 2;
+    b = lut[96 + (b >> 3)] << 2;
+
+    return swap8(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
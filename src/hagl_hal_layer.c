@@ -0,0 +1,400 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+This is the backend when layer compositing is enabled. There is no back
+buffer. Instead the application registers bitmaps as layers which are
+composed scanline by scanline on flush. While one line buffer is being
+sent with DMA the next line is composed into the other one.
+
+HAGL drawing functions draw into the selected layer. Coordinates are
+clipped by the main library to the display, but they still need to be
+clipped to the layer bitmap here.
+
+*/
+
+#include "hagl_hal.h"
+
+#ifdef HAGL_HAL_USE_LAYERS
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mipi_display.h>
+#include <mipi_dcs.h>
+
+#include <hagl/bitmap.h>
+#include <hagl/backend.h>
+#include <hagl/color.h>
+
+#include "hagl_hal_layer.h"
+#include "hagl_hal_kernel.h"
+#include "hagl_hal_mirror.h"
+
+static hagl_hal_layer_t layers[HAGL_HAL_LAYER_COUNT];
+static hagl_hal_layer_t *selected = &layers[0];
+static hagl_color_t lines[2][DISPLAY_WIDTH];
+
+static void
+compose(hagl_color_t *line, int16_t y)
+{
+    memset(line, 0, sizeof(lines[0]));
+
+    for (uint8_t i = 0; i < HAGL_HAL_LAYER_COUNT; i++) {
+        hagl_hal_layer_t *layer = &layers[i];
+        hagl_bitmap_t *bitmap = layer->bitmap;
+
+        if (!bitmap || !(layer->flags & HAGL_HAL_LAYER_VISIBLE)) {
+            continue;
+        }
+
+        int16_t row = y - layer->y0;
+        if (row < 0 || row >= bitmap->height) {
+            continue;
+        }
+
+        int16_t x0 = layer->x0 < 0 ? 0 : layer->x0;
+        int16_t x1 = layer->x0 + bitmap->width;
+        if (x1 > DISPLAY_WIDTH) {
+            x1 = DISPLAY_WIDTH;
+        }
+        if (x0 >= x1) {
+            continue;
+        }
+
+        hagl_color_t *src = (hagl_color_t *) (bitmap->buffer + row * bitmap->pitch);
+
+        /* Opaque layer is a straight copy. */
+        if (!(layer->flags & (HAGL_HAL_LAYER_COLOR_KEY | HAGL_HAL_LAYER_MASK))) {
+            hagl_hal_kernel_copy(&line[x0], &src[x0 - layer->x0], x1 - x0);
+            continue;
+        }
+
+        if (!(layer->flags & HAGL_HAL_LAYER_MASK)) {
+            hagl_hal_kernel_copy_key(&line[x0], &src[x0 - layer->x0], x1 - x0, layer->key);
+            continue;
+        }
+
+        const uint8_t *mask = NULL;
+        if (layer->flags & HAGL_HAL_LAYER_MASK) {
+            mask = layer->mask + row * ((bitmap->width + 7) / 8);
+        }
+
+        for (int16_t x = x0; x < x1; x++) {
+            uint16_t sx = x - layer->x0;
+
+            if (mask && !(mask[sx >> 3] & (0x80 >> (sx & 7)))) {
+                continue;
+            }
+            if ((layer->flags & HAGL_HAL_LAYER_COLOR_KEY) && src[sx] == layer->key) {
+                continue;
+            }
+            line[x] = src[sx];
+        }
+    }
+}
+
+static size_t
+flush(void *self)
+{
+    uint8_t current = 0;
+    uint16_t y1, y2;
+
+    /* In partial mode only the scanned rows are composed. */
+    mipi_display_active_rows(&y1, &y2);
+    mipi_display_begin(0, y1, DISPLAY_WIDTH, y2 - y1 + 1);
+
+#ifdef HAGL_HAL_USE_MIRROR
+    hagl_hal_mirror_begin(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+#endif /* HAGL_HAL_USE_MIRROR */
+
+    /* Compose next line while previous one is being sent. */
+    for (int16_t y = y1; y <= y2; y++) {
+        compose(lines[current], y);
+        mipi_display_stream_async((uint8_t *) lines[current], sizeof(lines[0]));
+#ifdef HAGL_HAL_USE_MIRROR
+        hagl_hal_mirror_row(y, lines[current]);
+#endif /* HAGL_HAL_USE_MIRROR */
+        current ^= 1;
+    }
+
+    mipi_display_end();
+
+#ifdef HAGL_HAL_USE_MIRROR
+    hagl_hal_mirror_end();
+#endif /* HAGL_HAL_USE_MIRROR */
+
+    return (y2 - y1 + 1) * sizeof(lines[0]);
+}
+
+static void
+put_pixel(void *self, int16_t x0, int16_t y0, hagl_color_t color)
+{
+    hagl_bitmap_t *bitmap = selected->bitmap;
+
+    if (!bitmap) {
+        return;
+    }
+
+    x0 -= selected->x0;
+    y0 -= selected->y0;
+
+    if (x0 < 0 || y0 < 0 || x0 >= bitmap->width || y0 >= bitmap->height) {
+        return;
+    }
+
+    bitmap->put_pixel(bitmap, x0, y0, color);
+}
+
+static hagl_color_t
+get_pixel(void *self, int16_t x0, int16_t y0)
+{
+    hagl_bitmap_t *bitmap = selected->bitmap;
+
+    if (!bitmap) {
+        return 0;
+    }
+
+    x0 -= selected->x0;
+    y0 -= selected->y0;
+
+    if (x0 < 0 || y0 < 0 || x0 >= bitmap->width || y0 >= bitmap->height) {
+        return 0;
+    }
+
+    return bitmap->get_pixel(bitmap, x0, y0);
+}
+
+static void
+hline(void *self, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
+{
+    hagl_bitmap_t *bitmap = selected->bitmap;
+
+    if (!bitmap) {
+        return;
+    }
+
+    int16_t x1 = x0 - selected->x0 + width;
+    x0 -= selected->x0;
+    y0 -= selected->y0;
+
+    if (x0 < 0) {
+        x0 = 0;
+    }
+    if (x1 > bitmap->width) {
+        x1 = bitmap->width;
+    }
+    if (y0 < 0 || y0 >= bitmap->height || x0 >= x1) {
+        return;
+    }
+
+    bitmap->hline(bitmap, x0, y0, x1 - x0, color);
+}
+
+static void
+vline(void *self, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
+{
+    hagl_bitmap_t *bitmap = selected->bitmap;
+
+    if (!bitmap) {
+        return;
+    }
+
+    int16_t y1 = y0 - selected->y0 + height;
+    x0 -= selected->x0;
+    y0 -= selected->y0;
+
+    if (y0 < 0) {
+        y0 = 0;
+    }
+    if (y1 > bitmap->height) {
+        y1 = bitmap->height;
+    }
+    if (x0 < 0 || x0 >= bitmap->width || y0 >= y1) {
+        return;
+    }
+
+    bitmap->vline(bitmap, x0, y0, y1 - y0, color);
+}
+
+static void
+blit(void *self, int16_t x0, int16_t y0, hagl_bitmap_t *src)
+{
+    hagl_bitmap_t *bitmap = selected->bitmap;
+
+    if (!bitmap) {
+        return;
+    }
+
+    x0 -= selected->x0;
+    y0 -= selected->y0;
+
+    int16_t sx0 = x0 < 0 ? -x0 : 0;
+    int16_t sy0 = y0 < 0 ? -y0 : 0;
+    int16_t sx1 = src->width;
+    int16_t sy1 = src->height;
+
+    if (x0 + sx1 > bitmap->width) {
+        sx1 = bitmap->width - x0;
+    }
+    if (y0 + sy1 > bitmap->height) {
+        sy1 = bitmap->height - y0;
+    }
+    if (sx0 >= sx1) {
+        return;
+    }
+
+    for (int16_t sy = sy0; sy < sy1; sy++) {
+        memcpy(
+            bitmap->buffer + (y0 + sy) * bitmap->pitch + (x0 + sx0) * sizeof(hagl_color_t),
+            src->buffer + sy * src->pitch + sx0 * sizeof(hagl_color_t),
+            (sx1 - sx0) * sizeof(hagl_color_t)
+        );
+    }
+}
+
+int8_t
+hagl_hal_layer_add(hagl_bitmap_t *bitmap, int16_t x0, int16_t y0)
+{
+    for (uint8_t i = 0; i < HAGL_HAL_LAYER_COUNT; i++) {
+        if (!layers[i].bitmap) {
+            layers[i].bitmap = bitmap;
+            layers[i].x0 = x0;
+            layers[i].y0 = y0;
+            layers[i].mask = NULL;
+            layers[i].key = 0;
+            layers[i].flags = HAGL_HAL_LAYER_VISIBLE;
+            hagl_hal_debug("Added %dx%d layer %d.\n", bitmap->width, bitmap->height, i);
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void
+hagl_hal_layer_remove(uint8_t layer)
+{
+    if (layer >= HAGL_HAL_LAYER_COUNT) {
+        return;
+    }
+
+    memset(&layers[layer], 0, sizeof(hagl_hal_layer_t));
+}
+
+void
+hagl_hal_layer_move(uint8_t layer, int16_t x0, int16_t y0)
+{
+    if (layer >= HAGL_HAL_LAYER_COUNT) {
+        return;
+    }
+
+    layers[layer].x0 = x0;
+    layers[layer].y0 = y0;
+}
+
+void
+hagl_hal_layer_color_key(uint8_t layer, hagl_color_t key)
+{
+    if (layer >= HAGL_HAL_LAYER_COUNT) {
+        return;
+    }
+
+    layers[layer].key = key;
+    layers[layer].flags |= HAGL_HAL_LAYER_COLOR_KEY;
+}
+
+void
+hagl_hal_layer_mask(uint8_t layer, const uint8_t *mask)
+{
+    if (layer >= HAGL_HAL_LAYER_COUNT) {
+        return;
+    }
+
+    layers[layer].mask = mask;
+    if (mask) {
+        layers[layer].flags |= HAGL_HAL_LAYER_MASK;
+    } else {
+        layers[layer].flags &= ~HAGL_HAL_LAYER_MASK;
+    }
+}
+
+void
+hagl_hal_layer_visible(uint8_t layer, bool visible)
+{
+    if (layer >= HAGL_HAL_LAYER_COUNT) {
+        return;
+    }
+
+    if (visible) {
+        layers[layer].flags |= HAGL_HAL_LAYER_VISIBLE;
+    } else {
+        layers[layer].flags &= ~HAGL_HAL_LAYER_VISIBLE;
+    }
+}
+
+void
+hagl_hal_layer_select(uint8_t layer)
+{
+    if (layer >= HAGL_HAL_LAYER_COUNT) {
+        return;
+    }
+
+    selected = &layers[layer];
+}
+
+/* Applies software color correction when the panel has no WRITE_LUT. */
+static hagl_color_t
+color(void *self, uint8_t r, uint8_t g, uint8_t b)
+{
+    return mipi_display_color(r, g, b);
+}
+
+void
+hagl_hal_init(hagl_backend_t *backend)
+{
+    mipi_display_init();
+
+    backend->width = MIPI_DISPLAY_WIDTH;
+    backend->height = MIPI_DISPLAY_HEIGHT;
+    backend->depth = MIPI_DISPLAY_DEPTH;
+    backend->put_pixel = put_pixel;
+    backend->color = color;
+    backend->get_pixel = get_pixel;
+    backend->hline = hline;
+    backend->vline = vline;
+    backend->blit = blit;
+    backend->flush = flush;
+}
+
+#endif /* HAGL_HAL_USE_LAYERS */
@@ -0,0 +1,308 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Frame mirroring encoder. Each row has a hash of its previous contents so
+unchanged rows can be skipped without keeping a copy of the frame. When
+the ring buffer fills up finished frames are drained to the sink. A frame
+larger than the buffer is sent in chunks. Only when the sink does not
+accept more the frame is cut after the last row which fit. Hashes of the
+remaining rows are left untouched so they are sent with one of the next
+frames.
+
+*/
+
+#include "hagl_hal.h"
+
+#ifdef HAGL_HAL_USE_MIRROR
+
+#include <string.h>
+#include <stdbool.h>
+
+#include <hagl/color.h>
+
+#include "hagl_hal_mirror.h"
+
+static hagl_hal_mirror_sink_t sink = NULL;
+static void *sink_context = NULL;
+
+static uint8_t ring[HAGL_HAL_MIRROR_BUFFER_SIZE];
+static uint32_t head = 0;
+static uint32_t tail = 0;
+/* Bytes before this belong to finished frames and can be sent. */
+static uint32_t committed = 0;
+
+static uint32_t hashes[DISPLAY_HEIGHT];
+
+static uint32_t frame_start;
+static uint16_t frame_width;
+static uint16_t frame_height;
+static uint16_t frame_rows;
+static bool frame_ok;
+/* Part of the frame was already sent as a chunk. */
+static bool frame_split;
+
+static hagl_hal_mirror_stats_t stats;
+
+static uint32_t
+hash(const hagl_color_t *pixels, uint16_t count)
+{
+    /* FNV-1a, never zero since zero marks an invalid row. */
+    uint32_t value = 2166136261u;
+
+    for (uint16_t i = 0; i < count; i++) {
+        value = (value ^ pixels[i]) * 16777619u;
+    }
+    return value | 1;
+}
+
+static bool
+put(const void *data, size_t size)
+{
+    const uint8_t *ptr = data;
+
+    if (!frame_ok) {
+        return false;
+    }
+
+    /* Make room by sending finished frames. */
+    if (size > HAGL_HAL_MIRROR_BUFFER_SIZE - (head - tail)) {
+        hagl_hal_mirror_drain();
+    }
+
+    if (size > HAGL_HAL_MIRROR_BUFFER_SIZE - (head - tail)) {
+        frame_ok = false;
+        return false;
+    }
+
+    while (size--) {
+        ring[head++ % HAGL_HAL_MIRROR_BUFFER_SIZE] = *(ptr++);
+    }
+    return true;
+}
+
+static bool
+put_u16(uint16_t value)
+{
+    uint8_t data[2] = {value & 0xff, value >> 8};
+    return put(data, 2);
+}
+
+static void
+header()
+{
+    /* Row count is patched in when the frame or chunk ends. */
+    frame_start = head;
+    frame_rows = 0;
+    put("HM", 2);
+    put_u16(frame_width);
+    put_u16(frame_height);
+    put_u16(0);
+}
+
+static void
+commit(bool last)
+{
+    /* Chunk which is continued by the next one is marked with 'HC'. */
+    if (!last) {
+        ring[(frame_start + 1) % HAGL_HAL_MIRROR_BUFFER_SIZE] = 'C';
+    }
+    ring[(frame_start + 6) % HAGL_HAL_MIRROR_BUFFER_SIZE] = frame_rows & 0xff;
+    ring[(frame_start + 7) % HAGL_HAL_MIRROR_BUFFER_SIZE] = frame_rows >> 8;
+    committed = head;
+
+    stats.encoded_bytes += head - frame_start;
+}
+
+static void
+encode(const hagl_color_t *pixels, uint16_t count)
+{
+    uint16_t i = 0;
+
+    while (i < count) {
+        uint16_t run = 1;
+
+        while (i + run < count && run < 128 && pixels[i + run] == pixels[i]) {
+            run++;
+        }
+
+        if (run > 1) {
+            uint8_t token = 0x80 | (run - 1);
+            put(&token, 1);
+            put(&pixels[i], sizeof(hagl_color_t));
+            i += run;
+            continue;
+        }
+
+        /* Literals until the next run of at least two pixels. */
+        uint16_t literal = 1;
+        while (i + literal < count && literal < 128
+               && !(i + literal + 1 < count && pixels[i + literal] == pixels[i + literal + 1])) {
+            literal++;
+        }
+
+        uint8_t token = literal - 1;
+        put(&token, 1);
+        put(&pixels[i], literal * sizeof(hagl_color_t));
+        i += literal;
+    }
+}
+
+void
+hagl_hal_mirror_init(hagl_hal_mirror_sink_t _sink, void *context)
+{
+    sink = _sink;
+    sink_context = context;
+    head = tail = committed = 0;
+    memset(&stats, 0, sizeof(stats));
+    hagl_hal_mirror_refresh();
+}
+
+void
+hagl_hal_mirror_refresh()
+{
+    memset(hashes, 0, sizeof(hashes));
+}
+
+void
+hagl_hal_mirror_begin(uint16_t width, uint16_t height)
+{
+    if (!sink) {
+        return;
+    }
+
+    frame_width = width;
+    frame_height = height;
+    frame_ok = true;
+    frame_split = false;
+
+    header();
+}
+
+void
+hagl_hal_mirror_row(uint16_t y, const hagl_color_t *pixels)
+{
+    if (!sink || !frame_ok || y >= DISPLAY_HEIGHT) {
+        return;
+    }
+
+    uint32_t value = hash(pixels, frame_width);
+    uint32_t row_start = head;
+
+    if (value == hashes[y]) {
+        return;
+    }
+
+    put_u16(y);
+    encode(pixels, frame_width);
+
+    /* Sink took everything, the frame alone fills the buffer. */
+    if (!frame_ok && tail == committed && frame_rows > 0) {
+        head = row_start;
+        commit(false);
+        hagl_hal_mirror_drain();
+
+        frame_ok = true;
+        frame_split = true;
+        header();
+
+        row_start = head;
+        put_u16(y);
+        encode(pixels, frame_width);
+    }
+
+    /* Sink is too slow, cut the frame before this row. */
+    if (!frame_ok) {
+        head = row_start;
+        return;
+    }
+
+    hashes[y] = value;
+    frame_rows++;
+}
+
+void
+hagl_hal_mirror_end()
+{
+    if (!sink) {
+        return;
+    }
+
+    /* Rows which did not fit are merged into one of the next frames. */
+    if (!frame_ok) {
+        stats.dropped++;
+    }
+
+    /* Split frame needs the last chunk even if it has no rows. */
+    if (0 == frame_rows && !frame_split) {
+        head = frame_start;
+    } else {
+        commit(true);
+
+        stats.frames++;
+        stats.raw_bytes += frame_width * frame_height * sizeof(hagl_color_t);
+    }
+
+    hagl_hal_mirror_drain();
+}
+
+void
+hagl_hal_mirror_drain()
+{
+    if (!sink) {
+        return;
+    }
+
+    while (tail != committed) {
+        uint32_t offset = tail % HAGL_HAL_MIRROR_BUFFER_SIZE;
+        uint32_t size = committed - tail;
+
+        /* Send only up to the end of the ring. */
+        if (size > HAGL_HAL_MIRROR_BUFFER_SIZE - offset) {
+            size = HAGL_HAL_MIRROR_BUFFER_SIZE - offset;
+        }
+
+        size_t sent = sink(sink_context, &ring[offset], size);
+        if (0 == sent) {
+            break;
+        }
+        tail += sent;
+    }
+}
+
+void
+hagl_hal_mirror_stats(hagl_hal_mirror_stats_t *dst)
+{
+    memcpy(dst, &stats, sizeof(hagl_hal_mirror_stats_t));
+}
+
+#endif /* HAGL_HAL_USE_MIRROR */
@@ -0,0 +1,247 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Bounded multi producer single consumer ring. Each cell has a sequence
+number which tells whether the cell is free for the producer claiming
+position pos (sequence == pos) or holds a published command for the
+consumer (sequence == pos + 1). Producers claim positions with compare
+and swap so no locks are needed.
+
+Cells store the sequence minus the cell index. This way zero initialized
+cells are already free for the first lap and no init function is needed.
+
+*/
+
+#ifdef HAGL_HAL_USE_RING
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include <hagl/backend.h>
+#include <hagl/bitmap.h>
+
+#include "hagl_hal_ring.h"
+
+#define RING_MASK (HAGL_HAL_RING_SIZE - 1)
+
+_Static_assert((HAGL_HAL_RING_SIZE & RING_MASK) == 0, "HAGL_HAL_RING_SIZE must be power of two");
+
+typedef struct {
+    _Atomic uint32_t sequence;
+    hagl_hal_command_t command;
+} cell_t;
+
+static cell_t cells[HAGL_HAL_RING_SIZE];
+static _Atomic uint32_t head;
+static uint32_t tail;
+
+/* Each producer id is used by one task only, no atomics needed. */
+static uint16_t sequences[HAGL_HAL_RING_PRODUCERS];
+static uint16_t expected[HAGL_HAL_RING_PRODUCERS];
+
+static _Atomic uint32_t full;
+static hagl_hal_ring_stats_t stats;
+
+static inline uint32_t
+load_sequence(uint32_t pos)
+{
+    cell_t *cell = &cells[pos & RING_MASK];
+    return atomic_load_explicit(&cell->sequence, memory_order_acquire) + (pos & RING_MASK);
+}
+
+static inline void
+store_sequence(uint32_t pos, uint32_t sequence)
+{
+    cell_t *cell = &cells[pos & RING_MASK];
+    atomic_store_explicit(&cell->sequence, sequence - (pos & RING_MASK), memory_order_release);
+}
+
+static void
+execute(hagl_backend_t *backend, const hagl_hal_command_t *command)
+{
+    stats.executed++;
+
+    switch (command->type) {
+        case HAGL_HAL_RING_PUT_PIXEL:
+            backend->put_pixel(backend, command->x0, command->y0, command->color);
+            break;
+        case HAGL_HAL_RING_HLINE:
+            backend->hline(backend, command->x0, command->y0, command->length, command->color);
+            break;
+        case HAGL_HAL_RING_VLINE:
+            backend->vline(backend, command->x0, command->y0, command->length, command->color);
+            break;
+        case HAGL_HAL_RING_BLIT:
+            backend->blit(backend, command->x0, command->y0, command->bitmap);
+            break;
+        case HAGL_HAL_RING_FLUSH:
+            if (backend->flush) {
+                backend->flush(backend);
+            }
+            break;
+    }
+}
+
+/* Try to merge next command into pending one. */
+static bool
+merge(hagl_hal_command_t *pending, const hagl_hal_command_t *next)
+{
+    if (pending->type == HAGL_HAL_RING_FLUSH && next->type == HAGL_HAL_RING_FLUSH) {
+        return true;
+    }
+
+    if (pending->color != next->color) {
+        return false;
+    }
+
+    /* Pixel or hline continuing on the same row. */
+    if ((pending->type == HAGL_HAL_RING_HLINE || pending->type == HAGL_HAL_RING_PUT_PIXEL)
+        && (next->type == HAGL_HAL_RING_HLINE || next->type == HAGL_HAL_RING_PUT_PIXEL)
+        && pending->y0 == next->y0) {
+
+        uint16_t length = pending->type == HAGL_HAL_RING_HLINE ? pending->length : 1;
+        uint16_t next_length = next->type == HAGL_HAL_RING_HLINE ? next->length : 1;
+
+        if (pending->x0 + length == next->x0) {
+            pending->type = HAGL_HAL_RING_HLINE;
+            pending->length = length + next_length;
+            return true;
+        }
+    }
+
+    /* Vline continuing on the same column. */
+    if (pending->type == HAGL_HAL_RING_VLINE
+        && next->type == HAGL_HAL_RING_VLINE
+        && pending->x0 == next->x0
+        && pending->y0 + pending->length == next->y0) {
+        pending->length += next->length;
+        return true;
+    }
+
+    return false;
+}
+
+bool
+hagl_hal_ring_submit(uint8_t producer, const hagl_hal_command_t *command)
+{
+    uint32_t pos;
+
+    /* Check before claiming a cell, claimed cell must be published. */
+    if (producer >= HAGL_HAL_RING_PRODUCERS) {
+        return false;
+    }
+
+    pos = atomic_load_explicit(&head, memory_order_relaxed);
+
+    for (;;) {
+        uint32_t sequence = load_sequence(pos);
+        int32_t diff = (int32_t) (sequence - pos);
+
+        if (0 == diff) {
+            if (atomic_compare_exchange_weak_explicit(
+                        &head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Consumer has not yet freed this cell. */
+            atomic_fetch_add_explicit(&full, 1, memory_order_relaxed);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&head, memory_order_relaxed);
+        }
+    }
+
+    cell_t *cell = &cells[pos & RING_MASK];
+    memcpy(&cell->command, command, sizeof(hagl_hal_command_t));
+    cell->command.producer = producer;
+    cell->command.sequence = sequences[producer]++;
+
+    /* Publish the command to the consumer. */
+    store_sequence(pos, pos + 1);
+
+    return true;
+}
+
+size_t
+hagl_hal_ring_drain(hagl_backend_t *backend)
+{
+    hagl_hal_command_t pending;
+    bool has_pending = false;
+    uint32_t executed = stats.executed;
+
+    for (;;) {
+        /* Empty or producer has not yet published. */
+        if (load_sequence(tail) != tail + 1) {
+            break;
+        }
+
+        hagl_hal_command_t command = cells[tail & RING_MASK].command;
+
+        /* Free the cell for the next lap. */
+        store_sequence(tail, tail + HAGL_HAL_RING_SIZE);
+        tail++;
+
+        if (command.producer < HAGL_HAL_RING_PRODUCERS) {
+            if (command.sequence != expected[command.producer]) {
+                stats.out_of_order++;
+            }
+            expected[command.producer] = command.sequence + 1;
+        }
+
+        if (has_pending && merge(&pending, &command)) {
+            stats.merged++;
+            continue;
+        }
+
+        if (has_pending) {
+            execute(backend, &pending);
+        }
+        pending = command;
+        has_pending = true;
+    }
+
+    if (has_pending) {
+        execute(backend, &pending);
+    }
+
+    return stats.executed - executed;
+}
+
+void
+hagl_hal_ring_stats(hagl_hal_ring_stats_t *dst)
+{
+    memcpy(dst, &stats, sizeof(hagl_hal_ring_stats_t));
+    dst->full = atomic_load_explicit(&full, memory_order_relaxed);
+}
+
+#endif /* HAGL_HAL_USE_RING */
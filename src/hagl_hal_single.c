@@ -49,6 +49,7 @@ valid.
 #include <hagl.h>
 
 #include "mipi_display.h"
+#include "hagl_hal_kernel.h"
 
 static void
 put_pixel(void *self, int16_t x0, int16_t y0, hagl_color_t color)
@@ -66,12 +67,9 @@ static void
 hline(void *self, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
 {
     static hagl_color_t line[DISPLAY_WIDTH];
-    hagl_color_t *ptr = line;
     uint16_t height = 1;
 
-    for (uint16_t x = 0; x < width; x++) {
-        *(ptr++) = color;
-    }
+    hagl_hal_kernel_fill(line, color, width);
 
     mipi_display_write(x0, y0, width, height, (uint8_t *) line);
 }
@@ -80,16 +78,20 @@ static void
 vline(void *self, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
 {
     static hagl_color_t line[DISPLAY_HEIGHT];
-    hagl_color_t *ptr = line;
     uint16_t width = 1;
 
-    for (uint16_t x = 0; x < height; x++) {
-        *(ptr++) = color;
-    }
+    hagl_hal_kernel_fill(line, color, height);
 
     mipi_display_write(x0, y0, width, height, (uint8_t *) line);
 }
 
+/* Applies software color correction when the panel has no WRITE_LUT. */
+static hagl_color_t
+color(void *self, uint8_t r, uint8_t g, uint8_t b)
+{
+    return mipi_display_color(r, g, b);
+}
+
 void
 hagl_hal_init(hagl_backend_t *backend)
 {
@@ -99,6 +101,7 @@ hagl_hal_init(hagl_backend_t *backend)
     backend->height = MIPI_DISPLAY_HEIGHT;
     backend->depth = MIPI_DISPLAY_DEPTH;
     backend->put_pixel = put_pixel;
+    backend->color = color;
     backend->blit = blit;
     backend->hline = hline;
     backend->vline = vline;
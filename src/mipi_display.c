@@ -34,33 +34,144 @@ SPDX-License-Identifier: MIT
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 // #include <stdatomic.h>
 
 #include "nuclei_sdk_soc.h"
 
 #include "mipi_dcs.h"
 #include "mipi_display.h"
+#include "mipi_vendor.h"
+#include "mipi_display_init.h"
+#include "mipi_dcs_stream.h"
+#include "hagl_hal_kernel.h"
 
-static const uint8_t DELAY_BIT = 1 << 7;
+#if MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_ST7735
+
+#define REFRESH_SETTING_MIN (0x00)
+#define REFRESH_SETTING_MAX (0x0F)
+
+#define HAS_WRITE_LUT
+#define HAS_GAMMA_CURVE
+
+static uint16_t
+refresh_rate(uint8_t rtna)
+{
+    return ST7735_FOSC / ((rtna * 2 + 40) * (ST7735_LINES + ST7735_FPA + ST7735_BPA + 2));
+}
+
+static void
+write_refresh_rate(uint8_t rtna)
+{
+    uint8_t data[] = {rtna, ST7735_FPA, ST7735_BPA};
+    mipi_display_ioctl(ST7735_FRMCTR1, data, sizeof(data));
+}
+
+#elif MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_ST7789
+
+#define REFRESH_SETTING_MIN (0x00)
+#define REFRESH_SETTING_MAX (0x1F)
+
+#define HAS_GAMMA_CURVE
+#define HAS_BRIGHTNESS
+
+static uint16_t
+refresh_rate(uint8_t rtna)
+{
+    return ST7789_FOSC / ((320 + ST7789_FPA + ST7789_BPA) * (250 + rtna * 16));
+}
+
+static void
+write_refresh_rate(uint8_t rtna)
+{
+    mipi_display_ioctl(ST7789_FRCTRL2, &rtna, 1);
+}
+
+#elif MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_ILI9341
+
+/* Setting has DIVA in bits 4-5 and RTNA - 16 in bits 0-3. */
+#define REFRESH_SETTING_MIN (0x00)
+#define REFRESH_SETTING_MAX (0x3F)
+
+#define HAS_WRITE_LUT
+#define HAS_GAMMA_CURVE
+#define HAS_BRIGHTNESS
+
+static uint16_t
+refresh_rate(uint8_t setting)
+{
+    uint8_t diva = setting >> 4;
+    uint8_t rtna = 0x10 + (setting & 0x0F);
+
+    return ILI9341_FOSC / ((1 << diva) * rtna * (320 + ILI9341_VFP + ILI9341_VBP));
+}
+
+static void
+write_refresh_rate(uint8_t setting)
+{
+    uint8_t data[] = {setting >> 4, 0x10 + (setting & 0x0F)};
+    mipi_display_ioctl(ILI9341_FRMCTR1, data, sizeof(data));
+}
+
+#elif MIPI_DISPLAY_CONTROLLER == MIPI_DISPLAY_CONTROLLER_GC9A01
+
+/* Refresh rate cannot be changed, see mipi_display_init.h. */
 
-static const mipi_init_command_t init_commands[] = {
-    {MIPI_DCS_SOFT_RESET, {0}, 0 | DELAY_BIT},
-    {MIPI_DCS_SET_ADDRESS_MODE, {MIPI_DISPLAY_ADDRESS_MODE}, 1},
-    {MIPI_DCS_SET_PIXEL_FORMAT, {MIPI_DISPLAY_PIXEL_FORMAT}, 1},
-#ifdef MIPI_DISPLAY_INVERT
-    {MIPI_DCS_ENTER_INVERT_MODE, {0}, 0},
 #else
-    {MIPI_DCS_EXIT_INVERT_MODE, {0}, 0},
+
+#define HAS_GAMMA_CURVE
+
 #endif
-    {MIPI_DCS_EXIT_SLEEP_MODE, {0}, 0 | DELAY_BIT},
-    {MIPI_DCS_SET_DISPLAY_ON, {0}, 0 | DELAY_BIT},
-    /* End of commands . */
-    {0, {0}, 0xff},
+
+#define TRANSFER_CALIBRATE_SIZE (64)
+
+static volatile uint8_t transfer_busy = MIPI_DISPLAY_TRANSFER_NONE;
+static const uint8_t *volatile irq_buffer;
+static volatile size_t irq_remaining = 0;
+
+static size_t interrupt_threshold = MIPI_DISPLAY_TRANSFER_INTERRUPT_THRESHOLD;
+static size_t dma_threshold = MIPI_DISPLAY_TRANSFER_DMA_THRESHOLD;
+static mipi_display_transfer_stats_t transfer_stats = {
+    .last = MIPI_DISPLAY_TRANSFER_NONE,
 };
 
+#ifndef HAS_WRITE_LUT
+static uint8_t software_lut[MIPI_DISPLAY_LUT_SIZE];
+static bool software_lut_enabled = false;
+#endif /* HAS_WRITE_LUT */
+
+static uint16_t active_y1 = 0;
+static uint16_t active_y2 = MIPI_DISPLAY_HEIGHT - 1;
+static bool normal_mode_pending = false;
+static bool window_full_screen = false;
+
+static uint32_t prescale = MIPI_DISPLAY_SPI_PRESCALE_COMMAND;
+static uint32_t pixel_prescale = MIPI_DISPLAY_SPI_PRESCALE_PIXEL;
+
+static void
+mipi_display_spi_prescale(uint32_t value)
+{
+    if (value == prescale) {
+        return;
+    }
+
+    /* Prescaler can be changed only when SPI is disabled. */
+    spi_disable(SPI0);
+    SPI_CTL0(SPI0) = (SPI_CTL0(SPI0) & ~SPI_CTL0_PSC) | value;
+    spi_enable(SPI0);
+
+    prescale = value;
+}
+
 static void
 mipi_display_write_command(const uint8_t command)
 {
+    /* Pending DMA transfer must finish before DC can be changed. */
+    mipi_display_wait();
+
+    /* Commands and their parameters use the slower clock. */
+    mipi_display_spi_prescale(MIPI_DISPLAY_SPI_PRESCALE_COMMAND);
+
     /* Set DC low to denote incoming command. */
     gpio_bit_reset(MIPI_DISPLAY_PORT_DC, MIPI_DISPLAY_PIN_DC);
 
@@ -107,15 +218,87 @@ mipi_display_write_data(const uint8_t *data, size_t length)
     }
 }
 
+/* Wait until the last byte has left the wire and release the bus. */
 static void
-mipi_display_write_data_dma(const uint8_t *buffer, size_t length)
+mipi_display_drain()
 {
-    size_t sent = 0;
+    while (RESET == spi_i2s_flag_get(SPI0, SPI_FLAG_TBE)) {};
+    while (SET == spi_i2s_flag_get(SPI0, SPI_FLAG_TRANS)) {};
 
-    if (0 == length) {
-        return;
-    };
+    /* Discard whatever was received and clear the overrun error. */
+    spi_i2s_data_receive(SPI0);
+    spi_i2s_flag_get(SPI0, SPI_FLAG_RXORERR);
+
+    /* Set CS high to ignore any traffic on SPI bus. */
+    gpio_bit_set(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
+}
+
+static void
+mipi_display_write_data_polled(const uint8_t *buffer, size_t length)
+{
+    /* Set DC high to denote incoming data. */
+    gpio_bit_set(MIPI_DISPLAY_PORT_DC, MIPI_DISPLAY_PIN_DC);
+
+    /* Set CS low to reserve the SPI bus for the whole transfer. */
+    gpio_bit_reset(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
+
+    for (size_t i = 0; i < length; i++) {
+        while (RESET == spi_i2s_flag_get(SPI0, SPI_FLAG_TBE)) {};
+        spi_i2s_data_transmit(SPI0, buffer[i]);
+    }
+
+    mipi_display_drain();
+}
+
+#ifdef MIPI_DISPLAY_TRANSFER_USE_INTERRUPT
+
+void
+SPI0_IRQHandler()
+{
+    if (irq_remaining > 0) {
+        spi_i2s_data_transmit(SPI0, *irq_buffer++);
+        irq_remaining = irq_remaining - 1;
+    }
 
+    /* Last byte is in the shift register, mipi_display_wait() does the rest. */
+    if (0 == irq_remaining) {
+        spi_i2s_interrupt_disable(SPI0, SPI_I2S_INT_TBE);
+    }
+}
+
+static void
+mipi_display_write_data_interrupt(const uint8_t *buffer, size_t length)
+{
+    /* Set DC high to denote incoming data. */
+    gpio_bit_set(MIPI_DISPLAY_PORT_DC, MIPI_DISPLAY_PIN_DC);
+
+    /* Set CS low to reserve the SPI bus. */
+    gpio_bit_reset(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
+
+    irq_buffer = buffer;
+    irq_remaining = length;
+    transfer_busy = MIPI_DISPLAY_TRANSFER_INTERRUPT;
+
+    /* Transmit buffer is empty so the first interrupt fires right away. */
+    spi_i2s_interrupt_enable(SPI0, SPI_I2S_INT_TBE);
+}
+
+#endif /* MIPI_DISPLAY_TRANSFER_USE_INTERRUPT */
+
+/* Interrupt path needs global interrupts enabled by the application. */
+static bool
+mipi_display_irq_enabled()
+{
+#ifdef MIPI_DISPLAY_TRANSFER_USE_INTERRUPT
+    return 0 != (__RV_CSR_READ(CSR_MSTATUS) & MSTATUS_MIE);
+#else
+    return false;
+#endif /* MIPI_DISPLAY_TRANSFER_USE_INTERRUPT */
+}
+
+static void
+mipi_display_write_data_dma(const uint8_t *buffer, size_t length)
+{
     /* Set DC high to denote incoming data. */
     gpio_bit_set(MIPI_DISPLAY_PORT_DC, MIPI_DISPLAY_PIN_DC);
 
@@ -123,22 +306,64 @@ mipi_display_write_data_dma(const uint8_t *buffer, size_t length)
     gpio_bit_set(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
 
     dma_channel_disable(DMA0, DMA_CH2);
+    dma_flag_clear(DMA0, DMA_CH2, DMA_FLAG_FTF);
     dma_memory_address_config(DMA0, DMA_CH2, (uint32_t)(buffer));
+    dma_transfer_number_config(DMA0, DMA_CH2, length);
 
-    /* Smells like off by one error somewhere? */
-    dma_transfer_number_config(DMA0, DMA_CH2, length - 1);
+    transfer_busy = MIPI_DISPLAY_TRANSFER_DMA;
 
     /* Set CS low to reserve the SPI bus. */
     gpio_bit_reset(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
     dma_channel_enable(DMA0, DMA_CH2);
 }
 
+/* MISO sharing a pin with CLK would read back the clock. */
+static bool
+mipi_display_has_miso()
+{
+    if (0 == MIPI_DISPLAY_PIN_MISO) {
+        return false;
+    }
+    if (MIPI_DISPLAY_PORT_MISO == MIPI_DISPLAY_PORT_CLK && MIPI_DISPLAY_PIN_MISO == MIPI_DISPLAY_PIN_CLK) {
+        hagl_hal_debug("%s\n", "MISO pin is the CLK pin, ignoring it.");
+        return false;
+    }
+    return true;
+}
+
+static uint8_t
+mipi_display_transfer(const uint8_t byte)
+{
+    while (RESET == spi_i2s_flag_get(SPI0, SPI_FLAG_TBE)) {};
+    spi_i2s_data_transmit(SPI0, byte);
+
+    while (RESET == spi_i2s_flag_get(SPI0, SPI_FLAG_RBNE)) {};
+    return spi_i2s_data_receive(SPI0);
+}
+
 static void
-mipi_display_read_data(uint8_t *data, size_t length)
+mipi_display_read_command(const uint8_t command, uint8_t *data, size_t length)
 {
-    if (0 == length) {
-        return;
-    };
+    mipi_display_wait();
+    mipi_display_spi_prescale(MIPI_DISPLAY_SPI_PRESCALE_READ);
+
+    /* Set DC low to denote incoming command. */
+    gpio_bit_reset(MIPI_DISPLAY_PORT_DC, MIPI_DISPLAY_PIN_DC);
+
+    /* CS must stay low for the whole read. */
+    gpio_bit_reset(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
+
+    mipi_display_transfer(command);
+
+    /* Set DC high to denote incoming data. */
+    gpio_bit_set(MIPI_DISPLAY_PORT_DC, MIPI_DISPLAY_PIN_DC);
+
+    for (size_t i = 0; i < length; i++) {
+        data[i] = mipi_display_transfer(0x00);
+    }
+
+    /* Set CS high to ignore any traffic on SPI bus. */
+    gpio_bit_set(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
 }
 
 static void
@@ -167,6 +392,9 @@ mipi_display_set_address(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
     mipi_display_write_data(data, 4);
 
     mipi_display_write_command(MIPI_DCS_WRITE_MEMORY_START);
+
+    /* Pixels use the faster clock. */
+    mipi_display_spi_prescale(pixel_prescale);
 }
 
 static void
@@ -195,6 +423,18 @@ mipi_display_dma_init()
     spi_dma_enable(SPI0, SPI_DMA_TRANSMIT);
 }
 
+static void
+mipi_display_irq_init()
+{
+#ifdef MIPI_DISPLAY_TRANSFER_USE_INTERRUPT
+    /* Handler is also installed by name for vector tables in flash. */
+    ECLIC_Register_IRQ(
+        SPI0_IRQn, ECLIC_NON_VECTOR_INTERRUPT, ECLIC_LEVEL_TRIGGER, 1, 0,
+        SPI0_IRQHandler
+    );
+#endif /* MIPI_DISPLAY_TRANSFER_USE_INTERRUPT */
+}
+
 static void
 mipi_display_spi_master_init()
 {
@@ -217,6 +457,11 @@ mipi_display_spi_master_init()
     gpio_init(MIPI_DISPLAY_PORT_CS, GPIO_MODE_OUT_PP, GPIO_OSPEED_50MHZ, MIPI_DISPLAY_PIN_CS);
     gpio_init(MIPI_DISPLAY_PORT_DC, GPIO_MODE_OUT_PP, GPIO_OSPEED_50MHZ, MIPI_DISPLAY_PIN_DC);
 
+    /* Reading is needed only for clock calibration. */
+    if (mipi_display_has_miso()) {
+        gpio_init(MIPI_DISPLAY_PORT_MISO, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, MIPI_DISPLAY_PIN_MISO);
+    }
+
     /* Set CS high to ignore any traffic on SPI bus. */
     gpio_bit_set(MIPI_DISPLAY_PORT_CS, MIPI_DISPLAY_PIN_CS);
 
@@ -226,7 +471,7 @@ mipi_display_spi_master_init()
     spi_config.frame_size = SPI_FRAMESIZE_8BIT;
     spi_config.clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE;
     spi_config.nss = SPI_NSS_SOFT;
-    spi_config.prescale = SPI_PSC_8;
+    spi_config.prescale = MIPI_DISPLAY_SPI_PRESCALE_COMMAND;
     spi_config.endian = SPI_ENDIAN_MSB;
     spi_init(SPI0, &spi_config);
 
@@ -237,10 +482,15 @@ mipi_display_spi_master_init()
 void
 mipi_display_init()
 {
+#ifndef MIPI_DISPLAY_INIT_STREAM
     uint8_t cmd = 0;
+#endif /* MIPI_DISPLAY_INIT_STREAM */
 
     /* Init the spi driver. */
     mipi_display_spi_master_init();
+    /* Init stream may contain pixels. */
+    mipi_display_dma_init();
+    mipi_display_irq_init();
     delay_1ms(100);
 
     /* Reset the display. */
@@ -252,22 +502,119 @@ mipi_display_init()
         delay_1ms(100);
     }
 
+#ifdef MIPI_DISPLAY_INIT_STREAM
+    /* Precompiled init stream given by user config. */
+    mipi_display_play(MIPI_DISPLAY_INIT_STREAM);
+#else
     /* Send all the commands. */
     while (init_commands[cmd].count != 0xff) {
         mipi_display_write_command(init_commands[cmd].command);
-        mipi_display_write_data(init_commands[cmd].data, init_commands[cmd].count & 0x1F);
+        mipi_display_write_data(init_commands[cmd].data, init_commands[cmd].count & COUNT_MASK);
         if (init_commands[cmd].count & DELAY_BIT) {
             delay_1ms(200);
         }
         cmd++;
     }
+#endif /* MIPI_DISPLAY_INIT_STREAM */
+
+#ifdef MIPI_DISPLAY_SPI_CALIBRATE
+    mipi_display_calibrate();
+#endif /* MIPI_DISPLAY_SPI_CALIBRATE */
+
+#ifdef MIPI_DISPLAY_TRANSFER_CALIBRATE
+    mipi_display_calibrate_transfer();
+#endif /* MIPI_DISPLAY_TRANSFER_CALIBRATE */
 
     /* Set the default viewport to full screen. */
     mipi_display_set_address(0, 0, MIPI_DISPLAY_WIDTH - 1, MIPI_DISPLAY_HEIGHT - 1);
+}
 
-#ifdef HAGL_HAL_USE_DOUBLE_BUFFER
-    mipi_display_dma_init();
-#endif /* HAGL_HAL_USE_DOUBLE_BUFFER */
+void
+mipi_display_wait()
+{
+    if (MIPI_DISPLAY_TRANSFER_DMA == transfer_busy) {
+        while (RESET == dma_flag_get(DMA0, DMA_CH2, DMA_FLAG_FTF)) {};
+        dma_flag_clear(DMA0, DMA_CH2, DMA_FLAG_FTF);
+
+        /* Idle channel must not react to requests from other transfers. */
+        dma_channel_disable(DMA0, DMA_CH2);
+    } else if (MIPI_DISPLAY_TRANSFER_INTERRUPT == transfer_busy) {
+        while (irq_remaining > 0) {};
+    } else {
+        return;
+    }
+
+    /* Last byte was written to SPI. Wait until it is sent. */
+    mipi_display_drain();
+
+    transfer_busy = MIPI_DISPLAY_TRANSFER_NONE;
+}
+
+void
+mipi_display_begin(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h)
+{
+    /* Narrower window would leave stale columns outside of it. */
+    window_full_screen = (0 == x1 && MIPI_DISPLAY_WIDTH == w && 0 == y1 && MIPI_DISPLAY_HEIGHT == h);
+    mipi_display_set_address(x1, y1, x1 + w - 1, y1 + h - 1);
+}
+
+static void
+mipi_display_stream_path(const uint8_t *buffer, size_t size, uint8_t path)
+{
+    transfer_stats.transfers[path]++;
+    transfer_stats.bytes[path] += size;
+    transfer_stats.last = path;
+
+    mipi_display_wait();
+
+    if (MIPI_DISPLAY_TRANSFER_POLLED == path) {
+        mipi_display_write_data_polled(buffer, size);
+#ifdef MIPI_DISPLAY_TRANSFER_USE_INTERRUPT
+    } else if (MIPI_DISPLAY_TRANSFER_INTERRUPT == path) {
+        mipi_display_write_data_interrupt(buffer, size);
+#endif /* MIPI_DISPLAY_TRANSFER_USE_INTERRUPT */
+    } else {
+        /* DMA can transfer at most 65535 bytes at once. */
+        while (size > 0) {
+            size_t chunk = size > 0xffff ? 0xffff : size;
+
+            mipi_display_wait();
+            mipi_display_write_data_dma(buffer, chunk);
+
+            buffer += chunk;
+            size -= chunk;
+        }
+    }
+}
+
+void
+mipi_display_stream(const uint8_t *buffer, size_t size)
+{
+    uint8_t path;
+
+    if (0 == size) {
+        return;
+    }
+
+    if (size >= dma_threshold) {
+        path = MIPI_DISPLAY_TRANSFER_DMA;
+    } else if (size >= interrupt_threshold && mipi_display_irq_enabled()) {
+        path = MIPI_DISPLAY_TRANSFER_INTERRUPT;
+    } else {
+        path = MIPI_DISPLAY_TRANSFER_POLLED;
+    }
+
+    mipi_display_stream_path(buffer, size, path);
+}
+
+void
+mipi_display_stream_async(const uint8_t *buffer, size_t size)
+{
+    if (0 == size) {
+        return;
+    }
+
+    mipi_display_stream_path(buffer, size, MIPI_DISPLAY_TRANSFER_DMA);
 }
 
 void
@@ -277,21 +624,26 @@ mipi_display_write(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uint8_t *bu
         return;
     }
 
-    int32_t x2 = x1 + w - 1;
-    int32_t y2 = y1 + h - 1;
-    uint32_t size = w * h;
+    mipi_display_begin(x1, y1, w, h);
+    mipi_display_stream(buffer, w * h * DISPLAY_DEPTH / 8);
+    mipi_display_end();
 
 #ifdef HAGL_HAL_USE_SINGLE_BUFFER
-    mipi_display_set_address(x1, y1, x2, y2);
-    mipi_display_write_data(buffer, size * DISPLAY_DEPTH / 8);
-#endif /* HAGL_HAL_SINGLE_BUFFER */
+    /* Single buffer callers reuse their buffers immediately. */
+    mipi_display_wait();
+#endif /* HAGL_HAL_USE_SINGLE_BUFFER */
+}
 
-#ifdef HAGL_HAL_USE_DOUBLE_BUFFER
-    mipi_display_write_data_dma(buffer, size * DISPLAY_DEPTH / 8);
-#endif /* HAGL_HAL_USE_DOUBLE_BUFFER */
+void
+mipi_display_end()
+{
+    /* All rows have now been written, safe to show them. */
+    if (normal_mode_pending && window_full_screen) {
+        mipi_display_write_command(MIPI_DCS_ENTER_NORMAL_MODE);
+        normal_mode_pending = false;
+    }
 }
 
-/* TODO: This most likely does not work with dma atm. */
 void
 mipi_display_ioctl(const uint8_t command, uint8_t *data, size_t size)
 {
@@ -314,8 +666,7 @@ mipi_display_ioctl(const uint8_t command, uint8_t *data, size_t size)
         case MIPI_DCS_GET_POWER_SAVE:
         case MIPI_DCS_READ_DDB_START:
         case MIPI_DCS_READ_DDB_CONTINUE:
-            mipi_display_write_command(command);
-            mipi_display_read_data(data, size);
+            mipi_display_read_command(command, data, size);
             break;
         default:
             mipi_display_write_command(command);
@@ -323,6 +674,415 @@ mipi_display_ioctl(const uint8_t command, uint8_t *data, size_t size)
     }
 }
 
+uint16_t
+mipi_display_set_refresh_rate(uint16_t hz)
+{
+#ifdef REFRESH_SETTING_MIN
+    uint8_t best = REFRESH_SETTING_MIN;
+
+    if (0 == hz) {
+        return 0;
+    }
+
+    /* Find register value closest to the requested refresh rate. */
+    for (uint8_t setting = REFRESH_SETTING_MIN; setting <= REFRESH_SETTING_MAX; setting++) {
+        if (abs(refresh_rate(setting) - hz) < abs(refresh_rate(best) - hz)) {
+            best = setting;
+        }
+    }
+
+    write_refresh_rate(best);
+    hagl_hal_debug("Refresh rate set to %d Hz.\n", refresh_rate(best));
+
+    return refresh_rate(best);
+#else
+    return 0;
+#endif /* REFRESH_SETTING_MIN */
+}
+
+bool
+mipi_display_set_lut(const uint8_t *lut)
+{
+    uint8_t identity[MIPI_DISPLAY_LUT_SIZE];
+
+    /* Identity maps 5 and 6 bit input to 6 bit output. */
+    if (!lut) {
+        for (uint8_t i = 0; i < 32; i++) {
+            identity[i] = identity[96 + i] = (i << 1) | (i >> 4);
+        }
+        for (uint8_t i = 0; i < 64; i++) {
+            identity[32 + i] = i;
+        }
+        lut = identity;
+    }
+
+#ifdef HAS_WRITE_LUT
+    mipi_display_ioctl(MIPI_DCS_WRITE_LUT, (uint8_t *) lut, MIPI_DISPLAY_LUT_SIZE);
+    return true;
+#else
+    memcpy(software_lut, lut, MIPI_DISPLAY_LUT_SIZE);
+    software_lut_enabled = (lut != identity);
+    return false;
+#endif /* HAS_WRITE_LUT */
+}
+
+bool
+mipi_display_set_gamma_curve(uint8_t curve)
+{
+#ifdef HAS_GAMMA_CURVE
+    mipi_display_ioctl(MIPI_DCS_SET_GAMMA_CURVE, &curve, 1);
+    return true;
+#else
+    return false;
+#endif /* HAS_GAMMA_CURVE */
+}
+
+bool
+mipi_display_set_brightness(uint8_t brightness)
+{
+#ifdef HAS_BRIGHTNESS
+    /* Enable brightness control block. */
+    uint8_t control = 0x24;
+    mipi_display_ioctl(MIPI_DCS_WRITE_CONTROL_DISPLAY, &control, 1);
+    mipi_display_ioctl(MIPI_DCS_SET_DISPLAY_BRIGHTNESS, &brightness, 1);
+    return true;
+#else
+    return false;
+#endif /* HAS_BRIGHTNESS */
+}
+
+hagl_color_t
+mipi_display_color(uint8_t r, uint8_t g, uint8_t b)
+{
+    uint16_t rgb;
+
+#ifndef HAS_WRITE_LUT
+    /* Same as the panel would do, see tools/lut_check.c. */
+    if (software_lut_enabled) {
+        return hagl_hal_kernel_rgb888_lut(software_lut, r, g, b);
+    }
+#endif /* HAS_WRITE_LUT */
+
+    rgb = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+
+    /* Swap bytes because they are sent MSB first. */
+    return (rgb >> 8) | (rgb << 8);
+}
+
+void
+mipi_display_color_apply(hagl_color_t *buffer, size_t count)
+{
+#ifndef HAS_WRITE_LUT
+    if (!software_lut_enabled) {
+        return;
+    }
+
+    while (count--) {
+        uint16_t rgb = (*buffer >> 8) | (*buffer << 8);
+        *(buffer++) = mipi_display_color(
+                          (rgb >> 8) & 0xF8, (rgb >> 3) & 0xFC, (rgb << 3) & 0xF8
+                      );
+    }
+#endif /* HAS_WRITE_LUT */
+}
+
+void
+mipi_display_partial_mode(uint16_t y1, uint16_t y2)
+{
+    uint8_t data[4];
+
+    if (y2 >= MIPI_DISPLAY_HEIGHT) {
+        y2 = MIPI_DISPLAY_HEIGHT - 1;
+    }
+    if (y1 > y2) {
+        y1 = y2;
+    }
+
+    active_y1 = y1;
+    active_y2 = y2;
+    normal_mode_pending = false;
+
+    y1 = y1 + MIPI_DISPLAY_OFFSET_Y;
+    y2 = y2 + MIPI_DISPLAY_OFFSET_Y;
+
+    /* Set the rows first so the old area is never scanned in partial mode. */
+    data[0] = y1 >> 8;
+    data[1] = y1 & 0xff;
+    data[2] = y2 >> 8;
+    data[3] = y2 & 0xff;
+    mipi_display_ioctl(MIPI_DCS_SET_PARTIAL_ROWS, data, 4);
+    mipi_display_ioctl(MIPI_DCS_ENTER_PARTIAL_MODE, NULL, 0);
+
+    hagl_hal_debug("Partial mode rows %d to %d.\n", active_y1, active_y2);
+}
+
+void
+mipi_display_normal_mode()
+{
+    active_y1 = 0;
+    active_y2 = MIPI_DISPLAY_HEIGHT - 1;
+
+#ifdef HAGL_HAL_USE_SINGLE_BUFFER
+    /* Display memory is always up to date. */
+    mipi_display_ioctl(MIPI_DCS_ENTER_NORMAL_MODE, NULL, 0);
+#else
+    /* Rows outside the partial area are stale until next full flush. */
+    normal_mode_pending = true;
+#endif /* HAGL_HAL_USE_SINGLE_BUFFER */
+}
+
+void
+mipi_display_idle_mode(bool idle)
+{
+    if (idle) {
+        mipi_display_ioctl(MIPI_DCS_ENTER_IDLE_MODE, NULL, 0);
+    } else {
+        mipi_display_ioctl(MIPI_DCS_EXIT_IDLE_MODE, NULL, 0);
+    }
+}
+
+void
+mipi_display_active_rows(uint16_t *y1, uint16_t *y2)
+{
+    *y1 = active_y1;
+    *y2 = active_y2;
+}
+
+/* Compare 18 bit read back to RGB565 pixels, allowing for dummy bits. */
+static bool
+mipi_display_verify(const uint8_t *pixels, size_t count, const uint8_t *rx, size_t rx_size)
+{
+    for (uint8_t shift = 0; shift < 16; shift++) {
+        bool match = true;
+
+        for (size_t i = 0; match && i < count; i++) {
+            uint16_t rgb = (pixels[i * 2] << 8) | pixels[i * 2 + 1];
+            uint8_t expected[3] = {(rgb >> 8) & 0xF8, (rgb >> 3) & 0xFC, (rgb << 3) & 0xF8};
+            uint8_t actual[3];
+
+            for (uint8_t j = 0; j < 3; j++) {
+                size_t bit = (i * 3 + j) * 8 + shift;
+                if (bit / 8 + 1 >= rx_size) {
+                    return false;
+                }
+                actual[j] = (rx[bit / 8] << (bit % 8)) | (rx[bit / 8 + 1] >> (8 - bit % 8));
+            }
+
+            /* Accept both RGB and BGR order. */
+            match = ((actual[1] & 0xFC) == expected[1])
+                    && (((actual[0] & 0xF8) == expected[0] && (actual[2] & 0xF8) == expected[2])
+                        || ((actual[0] & 0xF8) == expected[2] && (actual[2] & 0xF8) == expected[0]));
+        }
+
+        if (match) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* SPI_PSC_2 to SPI_PSC_256 are stored in bits 3 to 5 of SPI_CTL0. */
+static unsigned int
+mipi_display_prescale_divisor(uint32_t prescale)
+{
+    return 2u << ((prescale >> 3) & 0x07);
+}
+
+uint32_t
+mipi_display_calibrate()
+{
+    static const uint32_t prescales[] = {SPI_PSC_16, SPI_PSC_8, SPI_PSC_4, SPI_PSC_2};
+    static const uint8_t pattern[] = {
+        0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1F, 0xFF, 0xFF,
+        0xAA, 0xAA, 0x55, 0x55, 0x00, 0x00, 0xA5, 0x5A,
+    };
+    /* One full row so that the DMA runs as long as it does for frames. */
+    static uint8_t row[MIPI_DISPLAY_WIDTH * 2];
+    static uint8_t rx[MIPI_DISPLAY_WIDTH * 3 + 3];
+    uint32_t best = pixel_prescale;
+    uint16_t count = MIPI_DISPLAY_WIDTH;
+
+    if (!mipi_display_has_miso()) {
+        hagl_hal_debug("%s\n", "No MISO pin, cannot calibrate SPI clock.");
+        return pixel_prescale;
+    }
+
+    for (size_t i = 0; i < sizeof(row); i++) {
+        row[i] = pattern[i % sizeof(pattern)];
+    }
+
+    for (uint8_t i = 0; i < sizeof(prescales) / sizeof(prescales[0]); i++) {
+        pixel_prescale = prescales[i];
+
+        /* Frames are sent with DMA, test that path whatever the thresholds. */
+        mipi_display_set_address(0, 0, count - 1, 0);
+        mipi_display_stream_async(row, sizeof(row));
+        mipi_display_wait();
+
+        /* Read back with the read clock. */
+        mipi_display_set_address(0, 0, count - 1, 0);
+        mipi_display_read_command(MIPI_DCS_READ_MEMORY_START, rx, sizeof(rx));
+
+        if (!mipi_display_verify(row, count, rx, sizeof(rx))) {
+            hagl_hal_debug("SPI clock /%u failed.\n", mipi_display_prescale_divisor(prescales[i]));
+            break;
+        }
+        best = prescales[i];
+    }
+
+    pixel_prescale = best;
+    hagl_hal_debug("Using SPI clock /%u for pixels.\n", mipi_display_prescale_divisor(best));
+
+    return best;
+}
+
+uint32_t
+mipi_display_get_pixel_prescale()
+{
+    return pixel_prescale;
+}
+
+size_t
+mipi_display_calibrate_transfer()
+{
+    static const uint8_t pattern[TRANSFER_CALIBRATE_SIZE] = {0};
+    uint64_t start;
+    uint64_t polled;
+    uint64_t interrupt = 0;
+    uint64_t dma;
+
+    /* Black pixels to the top left corner with the pixel clock. */
+    mipi_display_set_address(0, 0, MIPI_DISPLAY_WIDTH - 1, MIPI_DISPLAY_HEIGHT - 1);
+
+    start = __get_rv_cycle();
+    mipi_display_write_data_polled(pattern, sizeof(pattern));
+    polled = __get_rv_cycle() - start;
+
+    /* Only the setup keeps the CPU busy, the rest runs in background. */
+    start = __get_rv_cycle();
+    mipi_display_write_data_dma(pattern, sizeof(pattern));
+    dma = __get_rv_cycle() - start;
+    mipi_display_wait();
+
+#ifdef MIPI_DISPLAY_TRANSFER_USE_INTERRUPT
+    if (mipi_display_irq_enabled()) {
+        start = __get_rv_cycle();
+        mipi_display_write_data_interrupt(pattern, sizeof(pattern));
+        mipi_display_wait();
+        interrupt = __get_rv_cycle() - start;
+    }
+#endif /* MIPI_DISPLAY_TRANSFER_USE_INTERRUPT */
+
+    /* Interrupt path was off if its threshold was not below DMA. */
+    bool interrupt_off = interrupt_threshold >= dma_threshold;
+
+    /* DMA pays off when polling would keep the CPU busy for longer. */
+    dma_threshold = dma * sizeof(pattern) / (polled ? polled : 1) + 1;
+
+    /* Interrupts pay off only if the handler keeps up with the bus. */
+    if (0 == interrupt || interrupt > polled + polled / 2) {
+        interrupt_threshold = dma_threshold;
+    } else {
+        if (interrupt_off) {
+            interrupt_threshold = sizeof(pattern) / 2;
+        }
+        if (interrupt_threshold > dma_threshold) {
+            interrupt_threshold = dma_threshold;
+        }
+    }
+
+    hagl_hal_debug(
+        "Polled %u, interrupt %u, DMA setup %u cycles per %u bytes.\n",
+        (unsigned int) polled, (unsigned int) interrupt, (unsigned int) dma,
+        (unsigned int) sizeof(pattern)
+    );
+    hagl_hal_debug(
+        "Using interrupts from %u and DMA from %u bytes.\n",
+        (unsigned int) interrupt_threshold, (unsigned int) dma_threshold
+    );
+
+    return dma_threshold;
+}
+
+void
+mipi_display_transfer_stats(mipi_display_transfer_stats_t *stats)
+{
+    *stats = transfer_stats;
+}
+
+static uint16_t
+read_u16(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+static uint32_t
+read_u32(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+void
+mipi_display_play(const uint8_t *stream)
+{
+    static hagl_color_t fill[2][32];
+    uint8_t current = 0;
+
+    for (;;) {
+        switch (*(stream++)) {
+            case MIPI_DCS_STREAM_COMMAND:
+                mipi_display_write_command(stream[0]);
+                mipi_display_write_data(&stream[2], stream[1]);
+                if (MIPI_DCS_WRITE_MEMORY_START == stream[0]) {
+                    mipi_display_spi_prescale(pixel_prescale);
+                }
+                stream += 2 + stream[1];
+                break;
+            case MIPI_DCS_STREAM_DELAY:
+                delay_1ms(read_u16(stream));
+                stream += 2;
+                break;
+            case MIPI_DCS_STREAM_WINDOW:
+                mipi_display_begin(
+                    read_u16(&stream[0]), read_u16(&stream[2]),
+                    read_u16(&stream[4]), read_u16(&stream[6])
+                );
+                stream += 8;
+                break;
+            case MIPI_DCS_STREAM_PIXELS: {
+                /* Sent straight from flash. */
+                uint32_t size = read_u32(stream);
+                mipi_display_stream_async(&stream[4], size);
+                stream += 4 + size;
+                break;
+            }
+            case MIPI_DCS_STREAM_FILL: {
+                uint32_t count = read_u32(stream);
+                hagl_color_t color;
+
+                memcpy(&color, &stream[4], sizeof(hagl_color_t));
+                while (count > 0) {
+                    uint32_t chunk = count > 32 ? 32 : count;
+
+                    /* Other buffer might still be sent by DMA. */
+                    hagl_hal_kernel_fill(fill[current], color, chunk);
+                    mipi_display_stream_async((uint8_t *) fill[current], chunk * sizeof(hagl_color_t));
+                    current ^= 1;
+                    count -= chunk;
+                }
+                stream += 6;
+                break;
+            }
+            case MIPI_DCS_STREAM_END:
+            default:
+                mipi_display_end();
+                /* Stream might not be in flash and can be freed after return. */
+                mipi_display_wait();
+                return;
+        }
+    }
+}
+
 void
 mipi_display_close()
 {
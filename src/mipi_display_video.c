@@ -0,0 +1,210 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Video playback using two DMA buffers. While one buffer is being sent the
+source fills the other. mipi_display_stream_async() waits for the previous
+transfer before starting the next one so the buffer being filled is
+always free.
+
+*/
+
+#include "hagl_hal.h"
+
+#ifdef HAGL_HAL_USE_VIDEO
+
+#include <string.h>
+#include <stdbool.h>
+
+#include "nuclei_sdk_soc.h"
+
+#include "mipi_display.h"
+#include "mipi_display_video.h"
+
+static uint8_t buffers[2][MIPI_DISPLAY_VIDEO_BUFFER_SIZE] __attribute__((aligned(4)));
+static uint8_t current = 0;
+
+static uint64_t
+now()
+{
+    return SysTimer_GetLoadValue();
+}
+
+static bool
+read_exact(const mipi_display_video_source_t *source, uint8_t *buffer, size_t size)
+{
+    return source->read(source->context, buffer, size) == size;
+}
+
+static bool
+read_u16(const mipi_display_video_source_t *source, uint16_t *value)
+{
+    uint8_t data[2];
+
+    if (!read_exact(source, data, 2)) {
+        return false;
+    }
+    *value = data[0] | (data[1] << 8);
+    return true;
+}
+
+/* Stream size bytes from source to display, or discard them. */
+static bool
+stream(const mipi_display_video_source_t *source, size_t size, bool send)
+{
+    if (!send && source->skip) {
+        return source->skip(source->context, size) == size;
+    }
+
+    while (size > 0) {
+        size_t chunk = size > MIPI_DISPLAY_VIDEO_BUFFER_SIZE ? MIPI_DISPLAY_VIDEO_BUFFER_SIZE : size;
+
+        if (!read_exact(source, buffers[current], chunk)) {
+            return false;
+        }
+        if (send) {
+            mipi_display_stream_async(buffers[current], chunk);
+            current ^= 1;
+        }
+        size -= chunk;
+    }
+    return true;
+}
+
+void
+mipi_display_video_play(
+    const mipi_display_video_source_t *source,
+    uint16_t x0, uint16_t y0, uint16_t width, uint16_t height,
+    uint16_t fps, mipi_display_video_stats_t *stats
+)
+{
+    mipi_display_video_stats_t local;
+    /* Zero fps plays as fast as possible. */
+    uint64_t period = fps ? SOC_TIMER_FREQ / fps : 0;
+    uint64_t start = now();
+    uint64_t deadline = start;
+    size_t pitch = width * DISPLAY_DEPTH / 8;
+    bool playing = true;
+
+    if (!stats) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(mipi_display_video_stats_t));
+
+    if (0 == width || 0 == height) {
+        return;
+    }
+
+    while (playing) {
+        uint8_t type;
+
+        if (!read_exact(source, &type, 1)) {
+            break;
+        }
+
+        /* Wait until it is time to show the frame. */
+        while (now() < deadline) {};
+
+        bool late = period && now() > deadline + period;
+        bool dropped = false;
+
+        switch (type) {
+            case MIPI_DISPLAY_VIDEO_UNCHANGED:
+                stats->unchanged++;
+                break;
+            case MIPI_DISPLAY_VIDEO_FULL:
+                /* Full frame can be dropped, the next one does not depend on it. */
+                if (late) {
+                    dropped = true;
+                    playing = stream(source, pitch * height, false);
+                    break;
+                }
+                mipi_display_begin(x0, y0, width, height);
+                playing = stream(source, pitch * height, true);
+                break;
+            case MIPI_DISPLAY_VIDEO_ROWS: {
+                uint16_t count;
+
+                playing = read_u16(source, &count);
+                while (playing && count--) {
+                    uint16_t y;
+                    uint16_t rows;
+
+                    playing = read_u16(source, &y) && read_u16(source, &rows);
+                    if (!playing || 0 == rows) {
+                        continue;
+                    }
+                    if (y >= height || rows > height - y) {
+                        hagl_hal_debug("Rows %d to %d outside of video.\n", y, y + rows - 1);
+                        playing = false;
+                        continue;
+                    }
+                    mipi_display_begin(x0, y0 + y, width, rows);
+                    playing = stream(source, pitch * rows, true);
+                }
+                break;
+            }
+            default:
+                hagl_hal_debug("Unknown video frame type %d.\n", type);
+                playing = false;
+        }
+
+        /* Truncated and unknown frames end playback without counting. */
+        if (!playing) {
+            break;
+        }
+
+        stats->frames++;
+        if (dropped) {
+            stats->dropped++;
+        } else if (late && MIPI_DISPLAY_VIDEO_ROWS == type) {
+            stats->late++;
+        }
+        deadline += period;
+    }
+
+    mipi_display_wait();
+
+    stats->elapsed_ms = (now() - start) * 1000 / SOC_TIMER_FREQ;
+    if (stats->elapsed_ms) {
+        /* Would overflow 32 bits after about 43000 frames. */
+        stats->fps_x100 = (uint64_t) (stats->frames - stats->dropped) * 100000 / stats->elapsed_ms;
+    }
+
+    hagl_hal_debug(
+        "Played %u frames, %u dropped, %u late, %u.%02u fps.\n",
+        (unsigned int) stats->frames, (unsigned int) stats->dropped, (unsigned int) stats->late,
+        (unsigned int) stats->fps_x100 / 100, (unsigned int) stats->fps_x100 % 100
+    );
+}
+
+#endif /* HAGL_HAL_USE_VIDEO */
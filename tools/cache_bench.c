@@ -0,0 +1,194 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host benchmark for the blit cache. Draws text with 8x8 glyphs once by
+rendering every glyph and sending it like blit() does, and once through
+hagl_hal_cache_blit() and hagl_hal_cache_put(). Cycles are counted with
+a model of GD32VF103 at 108 MHz with SPI at 13.5 MHz. Rendering and
+lookup costs are estimates, the display stand-in below also checks that
+every cached tile sent is the glyph which was asked for.
+
+    $ cc -DHAGL_HAL_USE_SINGLE_BUFFER -DHAGL_HAL_USE_BLIT_CACHE \
+        -Iinclude -Itools/dsp -Iexternal/hagl/include \
+        -o cache_bench tools/cache_bench.c src/hagl_hal_cache.c
+    $ ./cache_bench
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <hagl/bitmap.h>
+#include <hagl/color.h>
+
+#include "mipi_display.h"
+#include "hagl_hal_cache.h"
+
+#define CPU_HZ                  (108000000)
+/* SPI prescaler 8, eight bits per byte. */
+#define CYCLES_PER_BYTE         (64)
+/* Column and page address commands with their parameters. */
+#define WINDOW_BYTES            (11)
+#define DMA_SETUP_CYCLES        (150)
+#define RENDER_CYCLES_PER_PIXEL (30)
+#define LOOKUP_CYCLES           (200)
+
+#define GLYPHS                  (30)
+#define CHARACTERS              (100000)
+
+static uint64_t cpu = 0;
+static uint64_t bus_free = 0;
+
+static uint8_t font[GLYPHS][8];
+static hagl_color_t glyphs[GLYPHS][8 * 8];
+static const hagl_color_t *expected = NULL;
+static uint32_t errors = 0;
+
+/* Display driver stand-in which only counts cycles. */
+void
+mipi_display_wait()
+{
+    if (cpu < bus_free) {
+        cpu = bus_free;
+    }
+}
+
+void
+mipi_display_begin(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h)
+{
+    mipi_display_wait();
+    cpu += WINDOW_BYTES * CYCLES_PER_BYTE;
+}
+
+void
+mipi_display_end()
+{
+}
+
+void
+mipi_display_stream_async(const uint8_t *buffer, size_t size)
+{
+    if (expected && memcmp(buffer, expected, size)) {
+        errors++;
+    }
+    mipi_display_wait();
+    cpu += DMA_SETUP_CYCLES;
+    bus_free = cpu + size * CYCLES_PER_BYTE;
+}
+
+/* Glyphs are below the DMA threshold so they are polled. */
+void
+mipi_display_write(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uint8_t *buffer)
+{
+    mipi_display_begin(x1, y1, w, h);
+    cpu += w * h * sizeof(hagl_color_t) * CYCLES_PER_BYTE;
+}
+
+static void
+render(hagl_bitmap_t *bitmap, uint8_t glyph, hagl_color_t color, hagl_color_t background)
+{
+    hagl_color_t *pixels = (hagl_color_t *) bitmap->buffer;
+
+    for (uint8_t y = 0; y < 8; y++) {
+        for (uint8_t x = 0; x < 8; x++) {
+            pixels[y * 8 + x] = (font[glyph][y] & (0x80 >> x)) ? color : background;
+        }
+    }
+    cpu += 8 * 8 * RENDER_CYCLES_PER_PIXEL;
+}
+
+static double
+characters_per_second(uint64_t cycles)
+{
+    return (double) CHARACTERS * CPU_HZ / cycles;
+}
+
+int
+main()
+{
+    static hagl_color_t pixels[8 * 8];
+    static uint8_t text[CHARACTERS];
+    hagl_bitmap_t bitmap = {
+        .width = 8, .height = 8, .depth = 16, .pitch = 8 * sizeof(hagl_color_t),
+        .size = sizeof(pixels), .buffer = (uint8_t *) pixels,
+    };
+    hagl_hal_cache_stats_t stats;
+    uint64_t uncached;
+    uint64_t cached;
+
+    srand(1);
+    for (uint8_t i = 0; i < GLYPHS; i++) {
+        for (uint8_t y = 0; y < 8; y++) {
+            font[i][y] = rand();
+        }
+        render(&bitmap, i, 0xFFFF, 0x0000);
+        memcpy(glyphs[i], pixels, sizeof(pixels));
+    }
+    for (uint32_t i = 0; i < CHARACTERS; i++) {
+        text[i] = rand() % GLYPHS;
+    }
+
+    /* What blit() does for every character. */
+    cpu = bus_free = 0;
+    for (uint32_t i = 0; i < CHARACTERS; i++) {
+        render(&bitmap, text[i], 0xFFFF, 0x0000);
+        mipi_display_write((i % 20) * 8, 0, 8, 8, (uint8_t *) pixels);
+    }
+    mipi_display_wait();
+    uncached = cpu;
+
+    /* Cached by glyph identity and color pair. */
+    cpu = bus_free = 0;
+    for (uint32_t i = 0; i < CHARACTERS; i++) {
+        const void *id = &font[text[i]];
+
+        expected = glyphs[text[i]];
+        cpu += LOOKUP_CYCLES;
+        if (!hagl_hal_cache_blit((i % 20) * 8, 0, id, 0xFFFF, 0x0000)) {
+            render(&bitmap, text[i], 0xFFFF, 0x0000);
+            cpu += sizeof(pixels);
+            hagl_hal_cache_put((i % 20) * 8, 0, id, 0xFFFF, 0x0000, &bitmap);
+        }
+    }
+    mipi_display_wait();
+    cached = cpu;
+
+    hagl_hal_cache_stats(&stats);
+
+    printf("Uncached %.0f characters/s.\n", characters_per_second(uncached));
+    printf("Cached %.0f characters/s, %u hits, %u misses.\n",
+           characters_per_second(cached), stats.hits, stats.misses);
+    printf("%u wrong tiles.\n", errors);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,262 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Build time compiler for DCS command streams. Reads a text recording of
+DCS transactions and writes a C source file with the stream as a const
+array which can be played with mipi_display_play().
+
+    $ cc -o dcs_compile tools/dcs_compile.c
+    $ ./dcs_compile splash.dcs splash > splash.c
+
+Input has one transaction per line. Numbers can be decimal or hex.
+
+    # comment
+    cmd 0x36 0x08                   command with parameters
+    delay 120                       delay in milliseconds
+    window 0 0 80 160               set address window
+    pixels splash.raw               raw RGB565 in display byte order
+    fill 12800 0xf800               count copies of one pixel
+
+Runs of identical pixels in raw files are turned into fills.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../include/mipi_dcs_stream.h"
+
+/* Shorter runs are cheaper to send as pixels. */
+#define MIN_FILL    (16)
+
+static uint8_t *output = NULL;
+static size_t output_size = 0;
+static size_t output_capacity = 0;
+
+static void
+emit(uint8_t byte)
+{
+    if (output_size == output_capacity) {
+        output_capacity = output_capacity ? output_capacity * 2 : 4096;
+        output = realloc(output, output_capacity);
+        if (!output) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+    }
+    output[output_size++] = byte;
+}
+
+static void
+emit_u16(uint16_t value)
+{
+    emit(value & 0xff);
+    emit(value >> 8);
+}
+
+static void
+emit_u32(uint32_t value)
+{
+    emit_u16(value & 0xffff);
+    emit_u16(value >> 16);
+}
+
+static void
+emit_pixels(const uint8_t *data, size_t size)
+{
+    if (0 == size) {
+        return;
+    }
+    emit(MIPI_DCS_STREAM_PIXELS);
+    emit_u32(size);
+    while (size--) {
+        emit(*(data++));
+    }
+}
+
+static void
+emit_fill(uint32_t count, uint8_t hi, uint8_t lo)
+{
+    emit(MIPI_DCS_STREAM_FILL);
+    emit_u32(count);
+    emit(hi);
+    emit(lo);
+}
+
+static int
+compile_pixels(const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    uint8_t *data;
+    long size;
+
+    if (!file) {
+        fprintf(stderr, "Cannot open %s.\n", filename);
+        return 0;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file) & ~1L;
+    fseek(file, 0, SEEK_SET);
+
+    data = malloc(size ? size : 1);
+    if (!data || fread(data, 1, size, file) != (size_t) size) {
+        fprintf(stderr, "Cannot read %s.\n", filename);
+        fclose(file);
+        free(data);
+        return 0;
+    }
+    fclose(file);
+
+    long start = 0;
+    long i = 0;
+
+    while (i < size) {
+        long run = 2;
+        while (i + run < size
+               && data[i + run] == data[i]
+               && data[i + run + 1] == data[i + 1]) {
+            run += 2;
+        }
+
+        if (run / 2 >= MIN_FILL) {
+            emit_pixels(&data[start], i - start);
+            emit_fill(run / 2, data[i], data[i + 1]);
+            start = i + run;
+        }
+        i += run;
+    }
+    emit_pixels(&data[start], size - start);
+
+    free(data);
+    return 1;
+}
+
+static int
+compile_line(char *line)
+{
+    char *token = strtok(line, " \t\r\n");
+    long values[8];
+    int count = 0;
+
+    if (!token || '#' == token[0]) {
+        return 1;
+    }
+
+    if (0 == strcmp(token, "pixels")) {
+        char *filename = strtok(NULL, " \t\r\n");
+        return filename && compile_pixels(filename);
+    }
+
+    char *name = token;
+    char *param;
+    uint8_t data[256];
+
+    while ((param = strtok(NULL, " \t\r\n"))) {
+        long value = strtol(param, NULL, 0);
+        if (0 == strcmp(name, "cmd")) {
+            if (count >= 256) {
+                return 0;
+            }
+            data[count++] = value;
+        } else if (count < 8) {
+            values[count++] = value;
+        }
+    }
+
+    if (0 == strcmp(name, "cmd") && count >= 1) {
+        emit(MIPI_DCS_STREAM_COMMAND);
+        emit(data[0]);
+        emit(count - 1);
+        for (int i = 1; i < count; i++) {
+            emit(data[i]);
+        }
+    } else if (0 == strcmp(name, "delay") && 1 == count) {
+        emit(MIPI_DCS_STREAM_DELAY);
+        emit_u16(values[0]);
+    } else if (0 == strcmp(name, "window") && 4 == count) {
+        emit(MIPI_DCS_STREAM_WINDOW);
+        for (int i = 0; i < 4; i++) {
+            emit_u16(values[i]);
+        }
+    } else if (0 == strcmp(name, "fill") && 2 == count) {
+        emit_fill(values[0], values[1] >> 8, values[1] & 0xff);
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+int
+main(int argc, char *argv[])
+{
+    char line[1024];
+    int number = 0;
+    FILE *input;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s input.dcs name\n", argv[0]);
+        return 1;
+    }
+
+    input = fopen(argv[1], "r");
+    if (!input) {
+        fprintf(stderr, "Cannot open %s.\n", argv[1]);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), input)) {
+        number++;
+        if (!compile_line(line)) {
+            fprintf(stderr, "%s:%d: invalid line.\n", argv[1], number);
+            fclose(input);
+            return 1;
+        }
+    }
+    fclose(input);
+
+    emit(MIPI_DCS_STREAM_END);
+
+    printf("/* Generated by dcs_compile from %s, do not edit. */\n\n", argv[1]);
+    printf("#include <stdint.h>\n\n");
+    printf("const uint8_t %s[%zu] = {", argv[2], output_size);
+    for (size_t i = 0; i < output_size; i++) {
+        printf("%s0x%02x,", (i % 12) ? " " : "\n    ", output[i]);
+    }
+    printf("\n};\n");
+
+    free(output);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host stand-in for the SoC header used by tools/kernel_check.c. Emulates
+the P extension intrinsics used by hagl_hal_kernel.c in plain C.
+
+*/
+
+#ifndef _KERNEL_CHECK_NUCLEI_SDK_SOC_H
+#define _KERNEL_CHECK_NUCLEI_SDK_SOC_H
+
+#include <stdint.h>
+
+#define __DSP_PRESENT 1
+
+/* Lanes which are equal become 0xffff, others 0x0000. */
+static inline uint32_t
+__RV_CMPEQ16(uint32_t a, uint32_t b)
+{
+    uint32_t result = 0;
+
+    if ((a & 0xffff) == (b & 0xffff)) {
+        result |= 0x0000ffff;
+    }
+    if ((a >> 16) == (b >> 16)) {
+        result |= 0xffff0000;
+    }
+    return result;
+}
+
+/* Unsigned saturating add of each byte. */
+static inline uint32_t
+__RV_UKADD8(uint32_t a, uint32_t b)
+{
+    uint32_t result = 0;
+
+    for (uint8_t i = 0; i < 32; i += 8) {
+        uint32_t sum = ((a >> i) & 0xff) + ((b >> i) & 0xff);
+        result |= (sum > 0xff ? 0xff : sum) << i;
+    }
+    return result;
+}
+
+/* Swap the bytes of each halfword. */
+static inline uint32_t
+__RV_SWAP8(uint32_t a)
+{
+    return ((a & 0x00ff00ff) << 8) | ((a >> 8) & 0x00ff00ff);
+}
+
+#endif /* _KERNEL_CHECK_NUCLEI_SDK_SOC_H */
@@ -0,0 +1,205 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host side capture of the display init sequence. Runs the real
+mipi_display_init() against the stand-in SoC header in tools/mock and
+records the bytes sent over SPI, using the DC pin to tell commands from
+parameters. Capture starts when the reset pin is released. Output is in
+the text format of tools/dcs_compile.c so that it can be compared
+against the recorded streams in tools/golden.
+
+    $ cc -Wno-pointer-to-int-cast \
+        -DMIPI_DISPLAY_CONTROLLER=MIPI_DISPLAY_CONTROLLER_ST7789 \
+        -Iinclude -Itools/mock -Iexternal/hagl/include -o init_capture \
+        tools/init_capture.c src/mipi_display.c src/hagl_hal_kernel.c
+    $ ./init_capture | diff tools/golden/st7789.dcs -
+
+Run tools/init_check.sh to check all controllers.
+
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "nuclei_sdk_soc.h"
+#include "hagl_hal.h"
+#include "mipi_display.h"
+
+uint32_t mock_spi_ctl0 = 0;
+uint32_t mock_spi_data = 0;
+
+static bool dc = true;
+static bool cs = true;
+static bool capturing = (0 == MIPI_DISPLAY_PIN_RST);
+static bool line_open = false;
+static uint32_t errors = 0;
+
+static void
+end_line()
+{
+    if (line_open) {
+        printf("\n");
+        line_open = false;
+    }
+}
+
+static void
+gpio_write(uint32_t gpio_periph, uint32_t pin, bool level)
+{
+    if (MIPI_DISPLAY_PORT_DC == gpio_periph && MIPI_DISPLAY_PIN_DC == pin) {
+        dc = level;
+    }
+    if (MIPI_DISPLAY_PORT_CS == gpio_periph && MIPI_DISPLAY_PIN_CS == pin) {
+        cs = level;
+    }
+    if (MIPI_DISPLAY_PORT_RST == gpio_periph && MIPI_DISPLAY_PIN_RST == pin && level) {
+        capturing = true;
+    }
+}
+
+void
+gpio_bit_set(uint32_t gpio_periph, uint32_t pin)
+{
+    gpio_write(gpio_periph, pin, true);
+}
+
+void
+gpio_bit_reset(uint32_t gpio_periph, uint32_t pin)
+{
+    gpio_write(gpio_periph, pin, false);
+}
+
+void
+spi_i2s_data_transmit(uint32_t spi_periph, uint16_t data)
+{
+    if (!capturing) {
+        return;
+    }
+
+    if (cs) {
+        fprintf(stderr, "Byte 0x%02x sent with CS high.\n", data);
+        errors++;
+        return;
+    }
+
+    if (!dc) {
+        end_line();
+        printf("cmd 0x%02x", data);
+        line_open = true;
+    } else if (line_open) {
+        printf(" 0x%02x", data);
+    } else {
+        fprintf(stderr, "Parameter 0x%02x without command.\n", data);
+        errors++;
+    }
+}
+
+FlagStatus
+spi_i2s_flag_get(uint32_t spi_periph, uint32_t flag)
+{
+    /* Every byte is sent at once. */
+    return (SPI_FLAG_TBE == flag || SPI_FLAG_RBNE == flag) ? SET : RESET;
+}
+
+uint16_t
+spi_i2s_data_receive(uint32_t spi_periph)
+{
+    return 0;
+}
+
+void
+delay_1ms(uint32_t count)
+{
+    if (capturing) {
+        end_line();
+        printf("delay %u\n", (unsigned int) count);
+    }
+}
+
+void
+dma_channel_enable(uint32_t dma_periph, uint32_t channelx)
+{
+    /* Host pointers do not fit in the DMA address register. */
+    fprintf(stderr, "%s\n", "DMA transfers are not captured.");
+    errors++;
+}
+
+FlagStatus
+dma_flag_get(uint32_t dma_periph, uint32_t channelx, uint32_t flag)
+{
+    return SET;
+}
+
+/* Rest of the firmware library does nothing on the host. */
+void gpio_init(uint32_t gpio_periph, uint32_t mode, uint32_t speed, uint32_t pin) {}
+void rcu_periph_clock_enable(uint32_t periph) {}
+void spi_struct_para_init(spi_parameter_struct *spi_struct) {}
+void spi_init(uint32_t spi_periph, spi_parameter_struct *spi_struct) {}
+void spi_enable(uint32_t spi_periph) {}
+void spi_disable(uint32_t spi_periph) {}
+void spi_crc_polynomial_set(uint32_t spi_periph, uint16_t crc_poly) {}
+void spi_dma_enable(uint32_t spi_periph, uint8_t dma) {}
+void spi_i2s_interrupt_enable(uint32_t spi_periph, uint8_t interrupt) {}
+void spi_i2s_interrupt_disable(uint32_t spi_periph, uint8_t interrupt) {}
+void dma_deinit(uint32_t dma_periph, uint32_t channelx) {}
+void dma_struct_para_init(dma_parameter_struct *init_struct) {}
+void dma_init(uint32_t dma_periph, uint32_t channelx, dma_parameter_struct *init_struct) {}
+void dma_circulation_disable(uint32_t dma_periph, uint32_t channelx) {}
+void dma_memory_to_memory_disable(uint32_t dma_periph, uint32_t channelx) {}
+void dma_channel_disable(uint32_t dma_periph, uint32_t channelx) {}
+void dma_memory_address_config(uint32_t dma_periph, uint32_t channelx, uint32_t address) {}
+void dma_transfer_number_config(uint32_t dma_periph, uint32_t channelx, uint32_t number) {}
+void dma_memory_increase_enable(uint32_t dma_periph, uint32_t channelx) {}
+void dma_memory_increase_disable(uint32_t dma_periph, uint32_t channelx) {}
+void dma_flag_clear(uint32_t dma_periph, uint32_t channelx, uint32_t flag) {}
+uint64_t __get_rv_cycle(void) { return 0; }
+uint64_t SysTimer_GetLoadValue(void) { return 0; }
+
+int32_t
+ECLIC_Register_IRQ(uint32_t source, uint8_t mode, uint32_t trigger, uint8_t level, uint8_t priority, void *handler)
+{
+    return 0;
+}
+
+int
+main()
+{
+    mipi_display_init();
+    end_line();
+
+    if (cs) {
+        return errors ? 1 : 0;
+    }
+    fprintf(stderr, "%s\n", "CS left low.");
+    return 1;
+}
@@ -0,0 +1,34 @@
+#!/bin/sh
+#
+# Run the real mipi_display_init() of each display controller against
+# the mocked SoC in tools/mock and compare what it sends over SPI with
+# the hand written DCS stream in tools/golden. Comments in the golden
+# files say where the values come from. Run from the repository root.
+#
+# $ sh tools/init_check.sh
+#
+
+set -e
+
+CC=${CC:-cc}
+HAGL=${HAGL:-external/hagl/include}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+STATUS=0
+
+for CONTROLLER in GENERIC ST7735 ST7789 ILI9341 GC9A01; do
+    NAME=$(echo "$CONTROLLER" | tr 'A-Z' 'a-z')
+    $CC -Wno-pointer-to-int-cast \
+        -DMIPI_DISPLAY_CONTROLLER=MIPI_DISPLAY_CONTROLLER_$CONTROLLER \
+        -Iinclude -Itools/mock -I"$HAGL" -o "$TMP/init_capture" \
+        tools/init_capture.c src/mipi_display.c src/hagl_hal_kernel.c
+    grep -v '^#' "tools/golden/$NAME.dcs" > "$TMP/golden.dcs"
+    if "$TMP/init_capture" | diff -u "$TMP/golden.dcs" -; then
+        echo "$CONTROLLER ok"
+    else
+        echo "$CONTROLLER FAILED"
+        STATUS=1
+    fi
+done
+
+exit $STATUS
@@ -0,0 +1,145 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host check which compares the packed SIMD pixel kernels against the
+portable ones. P extension intrinsics are emulated by the stand-in SoC
+header in tools/dsp. Results must be bit-exact for every alignment and
+length.
+
+    $ cc -Iinclude -Itools/dsp -o kernel_check tools/kernel_check.c \
+        tools/kernel_check_dsp.c src/hagl_hal_kernel.c
+    $ ./kernel_check
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hagl_hal_kernel.h"
+
+void dsp_kernel_fill(hagl_color_t *dst, hagl_color_t color, size_t count);
+void dsp_kernel_fill_column(hagl_color_t *dst, size_t pitch, hagl_color_t color, size_t count);
+void dsp_kernel_copy(hagl_color_t *dst, const hagl_color_t *src, size_t count);
+void dsp_kernel_copy_key(hagl_color_t *dst, const hagl_color_t *src, size_t count, hagl_color_t key);
+void dsp_kernel_rgb888_to_rgb565(hagl_color_t *dst, const uint8_t *src, size_t count, uint16_t x0, uint16_t y0);
+void dsp_kernel_blend50(hagl_color_t *dst, const hagl_color_t *src, size_t count);
+
+#define SIZE        (80)
+#define ROUNDS      (200)
+
+static hagl_color_t src[SIZE + 2];
+static hagl_color_t expected[SIZE + 2];
+static hagl_color_t actual[SIZE + 2];
+static uint8_t rgb[(SIZE + 2) * 3];
+static uint32_t failures = 0;
+
+static void
+randomize(hagl_color_t key)
+{
+    for (uint16_t i = 0; i < SIZE + 2; i++) {
+        /* Every fourth pixel matches the color key. */
+        src[i] = (rand() & 3) ? rand() : key;
+        expected[i] = actual[i] = rand();
+    }
+    for (uint16_t i = 0; i < sizeof(rgb); i++) {
+        rgb[i] = rand();
+    }
+}
+
+static void
+compare(const char *name, size_t offset, size_t count)
+{
+    if (memcmp(expected, actual, sizeof(expected))) {
+        printf("%s failed, offset %u, count %u\n", name, (unsigned int) offset, (unsigned int) count);
+        failures++;
+    }
+}
+
+int
+main()
+{
+    srand(1);
+
+    for (uint16_t round = 0; round < ROUNDS; round++) {
+        for (size_t dst_offset = 0; dst_offset < 2; dst_offset++) {
+            for (size_t src_offset = 0; src_offset < 2; src_offset++) {
+                for (size_t count = 0; count <= SIZE; count++) {
+                    hagl_color_t key = rand();
+                    hagl_color_t color = rand();
+                    uint16_t x0 = rand();
+                    uint16_t y0 = rand();
+
+                    randomize(key);
+                    hagl_hal_kernel_fill(expected + dst_offset, color, count);
+                    dsp_kernel_fill(actual + dst_offset, color, count);
+                    compare("fill", dst_offset, count);
+
+                    randomize(key);
+                    hagl_hal_kernel_fill_column(expected + dst_offset, 4, color, count / 2);
+                    dsp_kernel_fill_column(actual + dst_offset, 4, color, count / 2);
+                    compare("fill_column", dst_offset, count);
+
+                    randomize(key);
+                    hagl_hal_kernel_copy(expected + dst_offset, src + src_offset, count);
+                    dsp_kernel_copy(actual + dst_offset, src + src_offset, count);
+                    compare("copy", dst_offset, count);
+
+                    randomize(key);
+                    hagl_hal_kernel_copy_key(expected + dst_offset, src + src_offset, count, key);
+                    dsp_kernel_copy_key(actual + dst_offset, src + src_offset, count, key);
+                    compare("copy_key", dst_offset, count);
+
+                    randomize(key);
+                    hagl_hal_kernel_rgb888_to_rgb565(expected + dst_offset, rgb + src_offset, count, x0, y0);
+                    dsp_kernel_rgb888_to_rgb565(actual + dst_offset, rgb + src_offset, count, x0, y0);
+                    compare("rgb888_to_rgb565", dst_offset, count);
+
+                    randomize(key);
+                    hagl_hal_kernel_blend50(expected + dst_offset, src + src_offset, count);
+                    dsp_kernel_blend50(actual + dst_offset, src + src_offset, count);
+                    compare("blend50", dst_offset, count);
+                }
+            }
+        }
+    }
+
+    if (failures) {
+        printf("%u failures\n", (unsigned int) failures);
+        return 1;
+    }
+
+    printf("DSP and portable kernels match.\n");
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+DSP build of hagl_hal_kernel.c for tools/kernel_check.c. Functions are
+renamed so that both builds can be linked into the same program.
+
+*/
+
+#define HAGL_HAL_USE_DSP
+
+#define hagl_hal_kernel_fill dsp_kernel_fill
+#define hagl_hal_kernel_fill_column dsp_kernel_fill_column
+#define hagl_hal_kernel_copy dsp_kernel_copy
+#define hagl_hal_kernel_copy_key dsp_kernel_copy_key
+#define hagl_hal_kernel_rgb888_to_rgb565 dsp_kernel_rgb888_to_rgb565
+#define hagl_hal_kernel_blend50 dsp_kernel_blend50
+#define hagl_hal_kernel_rgb888_lut dsp_kernel_rgb888_lut
+
+#include "../src/hagl_hal_kernel.c"
+
+#ifndef HAGL_HAL_KERNEL_DSP
+#error "DSP kernels were not compiled, check __DSP_PRESENT handling."
+#endif
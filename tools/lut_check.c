@@ -0,0 +1,169 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host check for the software color correction fallback. Emulates a panel
+with WRITE_LUT and compares what it shows against the software path,
+where the table is applied before sending and the panel expands RGB565
+with its default table. Every RGB888 color is checked with several
+tables.
+
+RGB565 carries only 5 bits of red and blue while the table outputs 6
+bits, so exact equality is impossible. Green must match exactly. Red
+and blue may differ by one 6 bit step.
+
+    $ cc -Iinclude -o lut_check tools/lut_check.c src/hagl_hal_kernel.c -lm
+    $ ./lut_check
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "hagl_hal_kernel.h"
+
+#define LUT_SIZE        (128)
+#define TOLERANCE       (1)
+
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} rgb666_t;
+
+/* Pixel as sent by mipi_display_color() when the panel does the work. */
+static hagl_color_t
+pack(uint8_t r, uint8_t g, uint8_t b)
+{
+    uint16_t rgb = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    return (rgb >> 8) | (rgb << 8);
+}
+
+/* What the panel shows for a pixel with the given table. */
+static rgb666_t
+panel(const uint8_t *lut, hagl_color_t pixel)
+{
+    uint16_t rgb = (pixel >> 8) | (pixel << 8);
+    rgb666_t result = {
+        .r = lut[rgb >> 11],
+        .g = lut[32 + ((rgb >> 5) & 0x3F)],
+        .b = lut[96 + (rgb & 0x1F)],
+    };
+    return result;
+}
+
+/* Same as mipi_display_set_lut(NULL). */
+static void
+identity(uint8_t *lut)
+{
+    for (uint8_t i = 0; i < 32; i++) {
+        lut[i] = lut[96 + i] = (i << 1) | (i >> 4);
+    }
+    for (uint8_t i = 0; i < 64; i++) {
+        lut[32 + i] = i;
+    }
+}
+
+static void
+gamma_curve(uint8_t *lut, double gamma)
+{
+    for (uint8_t i = 0; i < 32; i++) {
+        lut[i] = lut[96 + i] = lround(pow(i / 31.0, gamma) * 63);
+    }
+    for (uint8_t i = 0; i < 64; i++) {
+        lut[32 + i] = lround(pow(i / 63.0, gamma) * 63);
+    }
+}
+
+static uint32_t
+check(const char *name, const uint8_t *lut)
+{
+    uint8_t defaults[LUT_SIZE];
+    uint32_t failures = 0;
+
+    identity(defaults);
+
+    for (uint32_t color = 0; color < 0x1000000; color++) {
+        uint8_t r = color >> 16;
+        uint8_t g = color >> 8;
+        uint8_t b = color;
+
+        rgb666_t hardware = panel(lut, pack(r, g, b));
+        rgb666_t software = panel(defaults, hagl_hal_kernel_rgb888_lut(lut, r, g, b));
+
+        if (hardware.g != software.g
+            || abs(hardware.r - software.r) > TOLERANCE
+            || abs(hardware.b - software.b) > TOLERANCE) {
+            if (failures < 5) {
+                printf(
+                    "%s: #%06x panel %d %d %d, software %d %d %d\n", name, (unsigned int) color,
+                    hardware.r, hardware.g, hardware.b, software.r, software.g, software.b
+                );
+            }
+            failures++;
+        }
+    }
+
+    printf("%s: %u failures\n", name, (unsigned int) failures);
+    return failures;
+}
+
+int
+main()
+{
+    uint8_t lut[LUT_SIZE];
+    uint32_t failures = 0;
+
+    identity(lut);
+    failures += check("identity", lut);
+
+    gamma_curve(lut, 2.2);
+    failures += check("gamma 2.2", lut);
+
+    gamma_curve(lut, 0.45);
+    failures += check("gamma 0.45", lut);
+
+    for (uint8_t i = 0; i < LUT_SIZE; i++) {
+        lut[i] = 63 - (i < 32 ? (i << 1) | (i >> 4) : i < 96 ? i - 32 : ((i - 96) << 1) | ((i - 96) >> 4));
+    }
+    failures += check("inverted", lut);
+
+    srand(1);
+    for (uint8_t i = 0; i < LUT_SIZE; i++) {
+        lut[i] = rand() & 0x3F;
+    }
+    failures += check("random", lut);
+
+    return failures ? 1 : 0;
+}
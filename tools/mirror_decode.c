@@ -0,0 +1,184 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host side decoder for the frame mirroring stream. Reads the stream from
+stdin and writes each frame as binary PPM to stdout.
+
+    $ cc -o mirror_decode tools/mirror_decode.c
+    $ cat /dev/ttyUSB0 | ./mirror_decode | ffplay -f image2pipe -i -
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+static int
+read_u8(uint8_t *value)
+{
+    int c = getchar();
+
+    if (EOF == c) {
+        return 0;
+    }
+    *value = c;
+    return 1;
+}
+
+static int
+read_u16(uint16_t *value)
+{
+    uint8_t lo, hi;
+
+    if (!read_u8(&lo) || !read_u8(&hi)) {
+        return 0;
+    }
+    *value = lo | (hi << 8);
+    return 1;
+}
+
+static int
+read_pixel(uint16_t *value)
+{
+    uint8_t hi, lo;
+
+    /* Pixels are RGB565 in the byte order they are sent to the display. */
+    if (!read_u8(&hi) || !read_u8(&lo)) {
+        return 0;
+    }
+    *value = (hi << 8) | lo;
+    return 1;
+}
+
+static int
+decode_row(uint16_t *row, uint16_t width)
+{
+    uint16_t x = 0;
+
+    while (x < width) {
+        uint8_t token;
+        uint16_t pixel;
+
+        if (!read_u8(&token)) {
+            return 0;
+        }
+
+        uint16_t count = (token & 0x7F) + 1;
+        if (x + count > width) {
+            fprintf(stderr, "Row overflow, resyncing.\n");
+            return 0;
+        }
+
+        if (token & 0x80) {
+            if (!read_pixel(&pixel)) {
+                return 0;
+            }
+            while (count--) {
+                row[x++] = pixel;
+            }
+        } else {
+            while (count--) {
+                if (!read_pixel(&pixel)) {
+                    return 0;
+                }
+                row[x++] = pixel;
+            }
+        }
+    }
+    return 1;
+}
+
+static void
+write_ppm(const uint16_t *frame, uint16_t width, uint16_t height)
+{
+    printf("P6\n%d %d\n255\n", width, height);
+
+    for (uint32_t i = 0; i < (uint32_t) width * height; i++) {
+        uint16_t rgb = frame[i];
+        putchar(((rgb >> 11) & 0x1F) * 255 / 31);
+        putchar(((rgb >> 5) & 0x3F) * 255 / 63);
+        putchar((rgb & 0x1F) * 255 / 31);
+    }
+    fflush(stdout);
+}
+
+int
+main()
+{
+    uint16_t *frame = NULL;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t previous = 0;
+    uint8_t current;
+
+    while (read_u8(&current)) {
+        uint16_t w, h, rows;
+
+        /* Find the start of the next frame or chunk. */
+        if (!('H' == previous && ('M' == current || 'C' == current))) {
+            previous = current;
+            continue;
+        }
+        previous = 0;
+
+        if (!read_u16(&w) || !read_u16(&h) || !read_u16(&rows)) {
+            break;
+        }
+
+        if (w != width || h != height) {
+            width = w;
+            height = h;
+            free(frame);
+            frame = calloc((size_t) width * height, sizeof(uint16_t));
+            if (!frame) {
+                return 1;
+            }
+        }
+
+        int ok = 1;
+        while (ok && rows--) {
+            uint16_t y;
+
+            ok = read_u16(&y) && y < height && decode_row(&frame[(size_t) y * width], width);
+        }
+
+        /* Chunk is continued by the rest of the frame. */
+        if (ok && 'M' == current) {
+            write_ppm(frame, width, height);
+        }
+    }
+
+    free(frame);
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host stand-in for the SoC header used by tools/init_capture.c. Declares
+the parts of the GD32VF103 firmware library which src/mipi_display.c
+uses. The capture tool implements them and records what is sent over
+SPI.
+
+*/
+
+#ifndef _INIT_CAPTURE_NUCLEI_SDK_SOC_H
+#define _INIT_CAPTURE_NUCLEI_SDK_SOC_H
+
+#include <stdint.h>
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus;
+
+#define BIT(x)                      ((uint32_t) 1 << (x))
+
+/* GPIO */
+#define GPIOA                       (0x40010800)
+#define GPIOB                       (0x40010C00)
+#define GPIO_PIN_0                  BIT(0)
+#define GPIO_PIN_1                  BIT(1)
+#define GPIO_PIN_2                  BIT(2)
+#define GPIO_PIN_3                  BIT(3)
+#define GPIO_PIN_4                  BIT(4)
+#define GPIO_PIN_5                  BIT(5)
+#define GPIO_PIN_6                  BIT(6)
+#define GPIO_PIN_7                  BIT(7)
+#define GPIO_MODE_IN_FLOATING       (0x04)
+#define GPIO_MODE_OUT_PP            (0x10)
+#define GPIO_MODE_AF_PP             (0x18)
+#define GPIO_OSPEED_50MHZ           (0x03)
+
+void gpio_init(uint32_t gpio_periph, uint32_t mode, uint32_t speed, uint32_t pin);
+void gpio_bit_set(uint32_t gpio_periph, uint32_t pin);
+void gpio_bit_reset(uint32_t gpio_periph, uint32_t pin);
+
+/* RCU */
+#define RCU_GPIOA                   (1)
+#define RCU_GPIOB                   (2)
+#define RCU_AF                      (3)
+#define RCU_SPI0                    (4)
+#define RCU_DMA0                    (5)
+
+void rcu_periph_clock_enable(uint32_t periph);
+
+/* SPI */
+#define SPI0                        (0x40013000)
+extern uint32_t mock_spi_ctl0;
+extern uint32_t mock_spi_data;
+#define SPI_CTL0(spix)              (mock_spi_ctl0)
+#define SPI_DATA(spix)              (mock_spi_data)
+#define SPI_CTL0_PSC                (BIT(3) | BIT(4) | BIT(5))
+#define CTL0_PSC(regval)            (SPI_CTL0_PSC & ((uint32_t) (regval) << 3))
+#define SPI_PSC_2                   CTL0_PSC(0)
+#define SPI_PSC_4                   CTL0_PSC(1)
+#define SPI_PSC_8                   CTL0_PSC(2)
+#define SPI_PSC_16                  CTL0_PSC(3)
+#define SPI_PSC_32                  CTL0_PSC(4)
+#define SPI_PSC_64                  CTL0_PSC(5)
+#define SPI_PSC_128                 CTL0_PSC(6)
+#define SPI_PSC_256                 CTL0_PSC(7)
+#define SPI_TRANSMODE_FULLDUPLEX    (0)
+#define SPI_MASTER                  (BIT(2) | BIT(8))
+#define SPI_FRAMESIZE_8BIT          (0)
+#define SPI_CK_PL_LOW_PH_1EDGE      (0)
+#define SPI_NSS_SOFT                BIT(9)
+#define SPI_ENDIAN_MSB              (0)
+#define SPI_FLAG_RBNE               BIT(0)
+#define SPI_FLAG_TBE                BIT(1)
+#define SPI_FLAG_RXORERR            BIT(6)
+#define SPI_FLAG_TRANS              BIT(7)
+#define SPI_I2S_INT_TBE             (0)
+#define SPI_DMA_TRANSMIT            (0)
+
+typedef struct {
+    uint32_t device_mode;
+    uint32_t trans_mode;
+    uint32_t frame_size;
+    uint32_t nss;
+    uint32_t endian;
+    uint32_t clock_polarity_phase;
+    uint32_t prescale;
+} spi_parameter_struct;
+
+void spi_struct_para_init(spi_parameter_struct *spi_struct);
+void spi_init(uint32_t spi_periph, spi_parameter_struct *spi_struct);
+void spi_enable(uint32_t spi_periph);
+void spi_disable(uint32_t spi_periph);
+void spi_crc_polynomial_set(uint32_t spi_periph, uint16_t crc_poly);
+void spi_dma_enable(uint32_t spi_periph, uint8_t dma);
+void spi_i2s_data_transmit(uint32_t spi_periph, uint16_t data);
+uint16_t spi_i2s_data_receive(uint32_t spi_periph);
+FlagStatus spi_i2s_flag_get(uint32_t spi_periph, uint32_t flag);
+void spi_i2s_interrupt_enable(uint32_t spi_periph, uint8_t interrupt);
+void spi_i2s_interrupt_disable(uint32_t spi_periph, uint8_t interrupt);
+
+/* DMA */
+#define DMA0                        (0x40020000)
+#define DMA_CH2                     (2)
+#define DMA_FLAG_FTF                BIT(1)
+#define DMA_MEMORY_TO_PERIPHERAL    (1)
+#define DMA_MEMORY_WIDTH_8BIT       (0)
+#define DMA_PERIPHERAL_WIDTH_8BIT   (0)
+#define DMA_PRIORITY_LOW            (0)
+#define DMA_PRIORITY_ULTRA_HIGH     (3)
+#define DMA_PERIPH_INCREASE_DISABLE (0)
+#define DMA_MEMORY_INCREASE_ENABLE  (1)
+#define DMA_MEMORY_INCREASE_DISABLE (0)
+
+typedef struct {
+    uint32_t periph_addr;
+    uint32_t periph_width;
+    uint32_t memory_addr;
+    uint32_t memory_width;
+    uint32_t number;
+    uint32_t priority;
+    uint8_t periph_inc;
+    uint8_t memory_inc;
+    uint8_t direction;
+} dma_parameter_struct;
+
+void dma_deinit(uint32_t dma_periph, uint32_t channelx);
+void dma_struct_para_init(dma_parameter_struct *init_struct);
+void dma_init(uint32_t dma_periph, uint32_t channelx, dma_parameter_struct *init_struct);
+void dma_circulation_disable(uint32_t dma_periph, uint32_t channelx);
+void dma_memory_to_memory_disable(uint32_t dma_periph, uint32_t channelx);
+void dma_channel_enable(uint32_t dma_periph, uint32_t channelx);
+void dma_channel_disable(uint32_t dma_periph, uint32_t channelx);
+void dma_memory_address_config(uint32_t dma_periph, uint32_t channelx, uint32_t address);
+void dma_transfer_number_config(uint32_t dma_periph, uint32_t channelx, uint32_t number);
+void dma_memory_increase_enable(uint32_t dma_periph, uint32_t channelx);
+void dma_memory_increase_disable(uint32_t dma_periph, uint32_t channelx);
+FlagStatus dma_flag_get(uint32_t dma_periph, uint32_t channelx, uint32_t flag);
+void dma_flag_clear(uint32_t dma_periph, uint32_t channelx, uint32_t flag);
+
+/* Core */
+#define SOC_TIMER_FREQ              (27000000)
+#define SPI0_IRQn                   (54)
+#define ECLIC_NON_VECTOR_INTERRUPT  (0)
+#define ECLIC_LEVEL_TRIGGER         (0)
+#define CSR_MSTATUS                 (0x300)
+#define MSTATUS_MIE                 (0x08)
+#define __RV_CSR_READ(csr)          (0)
+
+void delay_1ms(uint32_t count);
+uint64_t __get_rv_cycle(void);
+uint64_t SysTimer_GetLoadValue(void);
+int32_t ECLIC_Register_IRQ(
+    uint32_t source, uint8_t mode, uint32_t trigger, uint8_t level, uint8_t priority, void *handler
+);
+
+#endif /* _INIT_CAPTURE_NUCLEI_SDK_SOC_H */
@@ -0,0 +1,147 @@
+/*
+
+MIT License
+
+Copyright (c) 2023 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the GD32V MIPI DCS HAL for the HAGL graphics library:
+https://github.com/tuupola/hagl_gd32v_mipi
+
+SPDX-License-Identifier: MIT
+
+-cut-
+
+Host stress test for the submission ring. Several threads submit
+commands at the same time while the main thread drains the ring. Checks
+that commands of each producer arrive in order and that none are lost
+or duplicated.
+
+    $ cc -pthread -DHAGL_HAL_USE_RING -Iinclude -Iexternal/hagl/include \
+        -o ring_stress tools/ring_stress.c src/hagl_hal_ring.c
+    $ ./ring_stress
+
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "hagl_hal_ring.h"
+
+#define COMMANDS    (100000)
+
+static uint32_t received[HAGL_HAL_RING_PRODUCERS];
+static uint32_t errors = 0;
+
+/* Producer id is in y0 and running number in x0 and color. */
+static void
+put_pixel(void *self, int16_t x0, int16_t y0, hagl_color_t color)
+{
+    uint16_t expected = received[y0];
+
+    if ((uint16_t) x0 != expected || color != (hagl_color_t) (expected * 3)) {
+        if (errors < 10) {
+            printf("Producer %d sent %u, expected %u.\n", y0, (uint16_t) x0, expected);
+        }
+        errors++;
+    }
+    received[y0]++;
+}
+
+static void *
+produce(void *arg)
+{
+    uint8_t producer = (uintptr_t) arg;
+
+    for (uint32_t i = 0; i < COMMANDS;) {
+        /* Colors never repeat within a row so nothing can be merged. */
+        hagl_hal_command_t command = {
+            .type = HAGL_HAL_RING_PUT_PIXEL,
+            .x0 = (int16_t) i,
+            .y0 = producer,
+            .color = (hagl_color_t) (i * 3),
+        };
+        if (hagl_hal_ring_submit(producer, &command)) {
+            i++;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+int
+main()
+{
+    pthread_t threads[HAGL_HAL_RING_PRODUCERS];
+    hagl_backend_t backend = {0};
+    hagl_hal_ring_stats_t stats;
+    uint32_t total = 0;
+
+    backend.put_pixel = put_pixel;
+
+    /* Unknown producer must be rejected without taking a cell. */
+    hagl_hal_command_t invalid = {.type = HAGL_HAL_RING_PUT_PIXEL};
+    if (hagl_hal_ring_submit(HAGL_HAL_RING_PRODUCERS, &invalid) || hagl_hal_ring_drain(&backend)) {
+        printf("Producer %u was accepted.\n", HAGL_HAL_RING_PRODUCERS);
+        errors++;
+    }
+
+    for (uintptr_t i = 0; i < HAGL_HAL_RING_PRODUCERS; i++) {
+        pthread_create(&threads[i], NULL, produce, (void *) i);
+    }
+
+    while (total < HAGL_HAL_RING_PRODUCERS * COMMANDS) {
+        if (0 == hagl_hal_ring_drain(&backend)) {
+            sched_yield();
+        }
+        total = 0;
+        for (uint8_t i = 0; i < HAGL_HAL_RING_PRODUCERS; i++) {
+            total += received[i];
+        }
+    }
+
+    for (uint8_t i = 0; i < HAGL_HAL_RING_PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* Nothing should be left behind. */
+    hagl_hal_ring_drain(&backend);
+    hagl_hal_ring_stats(&stats);
+
+    for (uint8_t i = 0; i < HAGL_HAL_RING_PRODUCERS; i++) {
+        if (received[i] != COMMANDS) {
+            printf("Producer %u: %u commands, expected %u.\n", i, received[i], COMMANDS);
+            errors++;
+        }
+    }
+    if (stats.executed != HAGL_HAL_RING_PRODUCERS * COMMANDS || stats.merged || stats.out_of_order) {
+        printf("Executed %u, merged %u, out of order %u.\n", stats.executed, stats.merged, stats.out_of_order);
+        errors++;
+    }
+
+    printf("%u commands, ring was full %u times, %u errors.\n", total, stats.full, errors);
+
+    return errors ? 1 : 0;
+}